@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+Высокопроизводительные аллокаторы для Vector/RawMemory (см. vector.h).
+
+Оба аллокатора совместимы с std::allocator_traits и подставляются вторым
+шаблонным параметром: Vector<T, BumpArenaAllocator<T>>. Буфер «переезжает»
+вместе со своим аллокатором при move/swap, поэтому все propagate-флаги
+включены.
+*/
+
+//Арена с линейным (bump) выделением.
+/*
+Память выделяется простым сдвигом указателя внутри крупных чанков и никогда
+не возвращается по одному блоку: вся арена освобождается целиком за O(1)
+вызовом Reset. Это убирает глобальную блокировку malloc на многопоточном
+ingest-пути — у каждого потока своя арена (см. ThreadLocal).
+*/
+class BumpArena {
+public:
+    explicit BumpArena(size_t chunk_size = kDefaultChunkSize) noexcept
+        : chunk_size_(chunk_size) {
+    }
+
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    ~BumpArena() {
+        FreeChunks(head_);
+    }
+
+    void* Allocate(size_t bytes, size_t align) {
+        char* aligned = AlignUp(ptr_, align);
+        if (aligned + bytes > end_) {
+            NewChunk(bytes + align);
+            aligned = AlignUp(ptr_, align);
+        }
+        ptr_ = aligned + bytes;
+        return aligned;
+    }
+
+    // Сбрасывает арену: первый (самый свежий) чанк остаётся под повторное
+    // использование, остальные возвращаются системе. Живых объектов в арене
+    // к этому моменту быть не должно.
+    void Reset() noexcept {
+        if (head_ != nullptr) {
+            FreeChunks(head_->next);
+            head_->next = nullptr;
+            ptr_ = head_->Data();
+            end_ = ptr_ + head_->size;
+        }
+    }
+
+    // Арена текущего потока — общая точка входа для BumpArenaAllocator.
+    static BumpArena& ThreadLocal() {
+        thread_local BumpArena arena;
+        return arena;
+    }
+
+private:
+    static constexpr size_t kDefaultChunkSize = 1 << 20;  // 1 МиБ
+
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+
+        char* Data() noexcept {
+            return reinterpret_cast<char*>(this) + sizeof(Chunk);
+        }
+    };
+
+    static char* AlignUp(char* p, size_t align) noexcept {
+        auto v = reinterpret_cast<uintptr_t>(p);
+        return reinterpret_cast<char*>((v + align - 1) & ~(align - 1));
+    }
+
+    void NewChunk(size_t min_bytes) {
+        const size_t payload = std::max(chunk_size_, min_bytes);
+        auto* chunk = static_cast<Chunk*>(operator new(sizeof(Chunk) + payload));
+        chunk->next = head_;
+        chunk->size = payload;
+        head_ = chunk;
+        ptr_ = chunk->Data();
+        end_ = ptr_ + payload;
+    }
+
+    static void FreeChunks(Chunk* chunk) noexcept {
+        while (chunk != nullptr) {
+            Chunk* next = chunk->next;
+            operator delete(chunk);
+            chunk = next;
+        }
+    }
+
+    Chunk* head_ = nullptr;
+    char* ptr_ = nullptr;
+    char* end_ = nullptr;
+    size_t chunk_size_;
+};
+
+//Аллокатор поверх BumpArena. deallocate — пустая операция.
+template <typename T>
+class BumpArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit BumpArenaAllocator(BumpArena& arena = BumpArena::ThreadLocal()) noexcept
+        : arena_(&arena) {
+    }
+
+    template <typename U>
+    BumpArenaAllocator(const BumpArenaAllocator<U>& other) noexcept
+        : arena_(&other.Arena()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {
+        // Память вернётся вся сразу при BumpArena::Reset.
+    }
+
+    BumpArena& Arena() const noexcept {
+        return *arena_;
+    }
+
+private:
+    BumpArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator==(const BumpArenaAllocator<T>& lhs, const BumpArenaAllocator<U>& rhs) noexcept {
+    return &lhs.Arena() == &rhs.Arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const BumpArenaAllocator<T>& lhs, const BumpArenaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+//Кэш отслуживших буферов.
+/*
+При каждом удвоении вектор выбрасывает прежний буфер, и соседний вектор тут
+же просит такой же — размеры роста у однотипных векторов повторяются. Кэш
+придерживает последние освобождённые блоки (точное совпадение размера,
+ограничение по числу и суммарному объёму) и отдаёт их без похода в malloc.
+Не поместившееся или слишком крупное освобождается обычным путём.
+*/
+class BufferCache {
+public:
+    BufferCache() = default;
+    BufferCache(const BufferCache&) = delete;
+    BufferCache& operator=(const BufferCache&) = delete;
+
+    ~BufferCache() {
+        Trim();
+    }
+
+    // Немедленно отпускает всё придержанное — например, в конце запроса,
+    // когда всплеск одноразовых векторов закончился и держать кэш незачем.
+    void Trim() noexcept {
+        for (size_t i = 0; i < count_; ++i) {
+            operator delete(entries_[i].ptr);
+        }
+        count_ = 0;
+        total_bytes_ = 0;
+    }
+
+    // Возвращает закэшированный блок ровно в bytes байт либо nullptr.
+    void* Take(size_t bytes) noexcept {
+        for (size_t i = 0; i < count_; ++i) {
+            if (entries_[i].bytes == bytes) {
+                void* ptr = entries_[i].ptr;
+                total_bytes_ -= bytes;
+                entries_[i] = entries_[--count_];
+                return ptr;
+            }
+        }
+        return nullptr;
+    }
+
+    // Принимает блок в кэш; false — места нет, блок остаётся у вызывающего.
+    bool Put(void* ptr, size_t bytes) noexcept {
+        if (count_ == kMaxEntries || bytes > kMaxBlockBytes
+            || total_bytes_ + bytes > kMaxTotalBytes) {
+            return false;
+        }
+        entries_[count_++] = {ptr, bytes};
+        total_bytes_ += bytes;
+        return true;
+    }
+
+    static BufferCache& ThreadLocal() {
+        thread_local BufferCache cache;
+        return cache;
+    }
+
+private:
+    static constexpr size_t kMaxEntries = 32;
+    static constexpr size_t kMaxBlockBytes = 4u << 20;   // один блок — до 4 МиБ
+    static constexpr size_t kMaxTotalBytes = 16u << 20;  // кэш целиком — до 16 МиБ
+
+    struct Entry {
+        void* ptr;
+        size_t bytes;
+    };
+
+    Entry entries_[kMaxEntries];
+    size_t count_ = 0;
+    size_t total_bytes_ = 0;
+};
+
+//Аллокатор поверх кэша буферов текущего потока.
+template <typename T>
+class RecyclingAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "RecyclingAllocator не поддерживает перевыравненные типы");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    RecyclingAllocator() noexcept = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = n * sizeof(T);
+        if (void* cached = BufferCache::ThreadLocal().Take(bytes)) {
+            return static_cast<T*>(cached);
+        }
+        return static_cast<T*>(operator new(bytes));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (!BufferCache::ThreadLocal().Put(ptr, n * sizeof(T))) {
+            operator delete(ptr);
+        }
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) noexcept {
+    return false;
+}
+
+//Аллокатор с усиленным выравниванием для SIMD-типов.
+/*
+Сами перевыравненные типы (alignas(32) и т.п.) Vector обслуживает и через
+std::allocator — operator new с C++17 учитывает выравнивание типа. Этот
+аллокатор нужен для другого случая: элементы обычные (float, int), а буфер
+должен лежать на границе SIMD-линии, чтобы _mm256_load_ps / выровненные
+AVX-512-загрузки работали с нулевого элемента:
+
+    Vector<float, AlignedAllocator<float, 64>> lanes;
+*/
+template <typename T, size_t Align = alignof(T)>
+class AlignedAllocator {
+    static_assert(Align >= alignof(T), "выравнивание не может быть слабее природного");
+    static_assert((Align & (Align - 1)) == 0, "выравнивание должно быть степенью двойки");
+
+public:
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Align>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Align>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{Align}));
+    }
+
+    void deallocate(T* ptr, size_t) noexcept {
+        operator delete(ptr, std::align_val_t{Align});
+    }
+};
+
+template <typename T, typename U, size_t A>
+bool operator==(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U, size_t A>
+bool operator!=(const AlignedAllocator<T, A>&, const AlignedAllocator<U, A>&) noexcept {
+    return false;
+}
+
+//Пул блоков по классам размера (степени двойки, 8 байт … 64 КиБ).
+/*
+Освобождённые блоки не возвращаются системе, а встают в односвязный
+free-list своего класса и переиспользуются следующим allocate. Это снимает
+нагрузку с malloc на коротко живущих векторах: после разогрева выделение —
+это снятие головы списка. Блоки крупнее 64 КиБ идут напрямую в operator new.
+Пул потоколокальный; блок, освобождённый в чужом потоке, попадёт в free-list
+этого потока.
+*/
+class SizeClassPool {
+public:
+    SizeClassPool() = default;
+    SizeClassPool(const SizeClassPool&) = delete;
+    SizeClassPool& operator=(const SizeClassPool&) = delete;
+
+    ~SizeClassPool() {
+        for (FreeNode*& head : free_lists_) {
+            while (head != nullptr) {
+                FreeNode* next = head->next;
+                operator delete(head);
+                head = next;
+            }
+        }
+    }
+
+    void* Allocate(size_t bytes) {
+        const size_t cls = ClassIndex(bytes);
+        if (cls > kMaxClass) {
+            return operator new(bytes);
+        }
+        if (FreeNode* node = free_lists_[cls]) {
+            free_lists_[cls] = node->next;
+            return node;
+        }
+        return operator new(size_t{1} << cls);
+    }
+
+    void Deallocate(void* ptr, size_t bytes) noexcept {
+        const size_t cls = ClassIndex(bytes);
+        if (cls > kMaxClass) {
+            operator delete(ptr);
+            return;
+        }
+        auto* node = static_cast<FreeNode*>(ptr);
+        node->next = free_lists_[cls];
+        free_lists_[cls] = node;
+    }
+
+    static SizeClassPool& ThreadLocal() {
+        thread_local SizeClassPool pool;
+        return pool;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static constexpr size_t kMinClass = 3;   // 8 байт — минимум под FreeNode
+    static constexpr size_t kMaxClass = 16;  // 64 КиБ
+
+    // Номер класса — ближайшая сверху степень двойки, не меньше 8 байт.
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t cls = kMinClass;
+        while ((size_t{1} << cls) < bytes) {
+            ++cls;
+        }
+        return cls;
+    }
+
+    FreeNode* free_lists_[kMaxClass + 1] = {};
+};
+
+//Аллокатор поверх SizeClassPool текущего потока.
+template <typename T>
+class PoolAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "PoolAllocator не поддерживает перевыравненные типы");
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    PoolAllocator() noexcept = default;
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(SizeClassPool::ThreadLocal().Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        SizeClassPool::ThreadLocal().Deallocate(ptr, n * sizeof(T));
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept {
+    return false;
+}
@@ -0,0 +1,268 @@
+//Микробенчмарки Vector против std::vector.
+/*
+Отдельная цель сборки для отслеживания регрессий производительности.
+Зависимостей нет — замеры на std::chrono, берётся лучший из нескольких
+прогонов. Счётчик аллокаций реализован перехватом malloc/realloc/calloc
+(см. ниже), чтобы malloc-размещённые буферы Vector считались наравне с
+operator new.
+
+Сборка и запуск:
+    g++ -std=c++17 -O2 -DNDEBUG benchmark.cpp -o bench && ./bench
+
+Для каждого кейса печатаются элементы/сек, байты/сек и число аллокаций
+за прогон — эти числа и сравниваются от коммита к коммиту.
+*/
+
+#include "vector.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+size_t g_allocations = 0;
+
+}  // namespace
+
+//Счётчик аллокаций: перехват malloc/realloc/calloc.
+/*
+Перегрузки глобального operator new недостаточно: буферы Vector для
+тривиально копируемых типов размещаются напрямую через malloc и растут
+через realloc (см. RawMemory::kCanReallocate в vector.h), минуя operator
+new. В glibc operator new сам сводится к malloc, поэтому перехват на
+уровне malloc считает аллокации Vector и std::vector одинаково честно.
+*/
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_calloc(size_t n, size_t size);
+
+void* malloc(size_t size) {
+    ++g_allocations;
+    return __libc_malloc(size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    ++g_allocations;
+    return __libc_realloc(ptr, size);
+}
+
+void* calloc(size_t n, size_t size) {
+    ++g_allocations;
+    return __libc_calloc(n, size);
+}
+
+}  // extern "C"
+
+namespace {
+
+// 32-байтная тривиально копируемая запись — типичный "тик"
+struct Tick {
+    double price;
+    double amount;
+    long long ts;
+    int id;
+    int flags;
+};
+
+// Тип с нетривиальным копированием: реаллокация идёт по move-ветке,
+// но конструктор копирования не noexcept
+struct Heavy {
+    std::string payload = "0123456789012345678901234567890123456789";
+    Heavy() = default;
+    Heavy(const Heavy&) = default;
+    Heavy(Heavy&& other) noexcept = default;
+    Heavy& operator=(const Heavy&) = default;
+    Heavy& operator=(Heavy&&) noexcept = default;
+};
+
+volatile size_t g_sink = 0;  // защита от выбрасывания замеряемого кода
+
+using Clock = std::chrono::steady_clock;
+
+// Запускает fn несколько раз и печатает лучший результат.
+// elems и bytes — объём работы одного прогона.
+template <typename Fn>
+void RunCase(const char* name, size_t elems, size_t bytes, Fn fn) {
+    constexpr int kRuns = 5;
+    double best_sec = 1e100;
+    size_t allocs = 0;
+    for (int run = 0; run < kRuns; ++run) {
+        const size_t allocs_before = g_allocations;
+        const auto start = Clock::now();
+        fn();
+        const auto stop = Clock::now();
+        const double sec = std::chrono::duration<double>(stop - start).count();
+        if (sec < best_sec) {
+            best_sec = sec;
+            allocs = g_allocations - allocs_before;
+        }
+    }
+    std::printf("%-34s %10.1f Melem/s %10.1f MiB/s %8zu allocs\n",
+                name,
+                elems / best_sec / 1e6,
+                bytes / best_sec / (1024.0 * 1024.0),
+                allocs);
+}
+
+template <typename V>
+void PushBackGrowth(size_t n) {
+    V v;
+    for (size_t i = 0; i < n; ++i) {
+        v.PushBack(typename V::value_type_alias{});
+    }
+    g_sink += reinterpret_cast<uintptr_t>(&v[n - 1]);
+}
+
+// std::vector и Vector именуют методы по-разному — тонкие обёртки
+// выравнивают интерфейсы для общих шаблонов замеров.
+template <typename T>
+struct Ours {
+    using value_type_alias = T;
+    Vector<T> v;
+    void PushBack(T&& x) { v.PushBack(std::move(x)); }
+    T& operator[](size_t i) { return v[i]; }
+};
+
+template <typename T>
+struct Std {
+    using value_type_alias = T;
+    std::vector<T> v;
+    void PushBack(T&& x) { v.push_back(std::move(x)); }
+    T& operator[](size_t i) { return v[i]; }
+};
+
+template <typename T>
+void BenchPushBack(const char* label, size_t n) {
+    char name[128];
+    std::snprintf(name, sizeof(name), "PushBack/%s/Vector", label);
+    RunCase(name, n, n * sizeof(T), [n] { PushBackGrowth<Ours<T>>(n); });
+    std::snprintf(name, sizeof(name), "PushBack/%s/std", label);
+    RunCase(name, n, n * sizeof(T), [n] { PushBackGrowth<Std<T>>(n); });
+}
+
+void BenchReserveFill(size_t n) {
+    RunCase("Reserve+fill/Tick/Vector", n, n * sizeof(Tick), [n] {
+        Vector<Tick> v;
+        v.Reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            v.PushBack(Tick{});
+        }
+        g_sink += reinterpret_cast<uintptr_t>(&v[0]);
+    });
+    RunCase("Reserve+fill/Tick/std", n, n * sizeof(Tick), [n] {
+        std::vector<Tick> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(Tick{});
+        }
+        g_sink += reinterpret_cast<uintptr_t>(&v[0]);
+    });
+}
+
+void BenchEmplaceMiddle(size_t n) {
+    RunCase("Emplace/middle/int/Vector", n, n * sizeof(int), [n] {
+        Vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.Emplace(v.begin() + v.Size() / 2, static_cast<int>(i));
+        }
+        g_sink += static_cast<size_t>(v[0]);
+    });
+    RunCase("Emplace/middle/int/std", n, n * sizeof(int), [n] {
+        std::vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.emplace(v.begin() + v.size() / 2, static_cast<int>(i));
+        }
+        g_sink += static_cast<size_t>(v[0]);
+    });
+    RunCase("Emplace/front/int/Vector", n, n * sizeof(int), [n] {
+        Vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.Emplace(v.begin(), static_cast<int>(i));
+        }
+        g_sink += static_cast<size_t>(v[0]);
+    });
+    RunCase("Emplace/front/int/std", n, n * sizeof(int), [n] {
+        std::vector<int> v;
+        for (size_t i = 0; i < n; ++i) {
+            v.emplace(v.begin(), static_cast<int>(i));
+        }
+        g_sink += static_cast<size_t>(v[0]);
+    });
+}
+
+void BenchErase(size_t n) {
+    RunCase("Erase/front/Tick/Vector", n, n * sizeof(Tick), [n] {
+        Vector<Tick> v(n);  // как и std-строка: одна аллокация на вход
+        while (v.Size() > 0) {
+            v.Erase(v.begin());
+        }
+    });
+    RunCase("Erase/front/Tick/std", n, n * sizeof(Tick), [n] {
+        std::vector<Tick> v(n);
+        while (!v.empty()) {
+            v.erase(v.begin());
+        }
+    });
+}
+
+void BenchCopyAssign(size_t n) {
+    // Ветка с переиспользованием ёмкости
+    RunCase("CopyAssign/reuse/Vector", n, n * sizeof(Tick), [n] {
+        Vector<Tick> src(n);
+        Vector<Tick> dst(n);
+        dst = src;
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+    RunCase("CopyAssign/reuse/std", n, n * sizeof(Tick), [n] {
+        std::vector<Tick> src(n);
+        std::vector<Tick> dst(n);
+        dst = src;
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+    // Ветка с выделением новой памяти
+    RunCase("CopyAssign/alloc/Vector", n, n * sizeof(Tick), [n] {
+        Vector<Tick> src(n);
+        Vector<Tick> dst;
+        dst = src;
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+    RunCase("CopyAssign/alloc/std", n, n * sizeof(Tick), [n] {
+        std::vector<Tick> src(n);
+        std::vector<Tick> dst;
+        dst = src;
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+}
+
+void BenchMoveConstruct(size_t n) {
+    RunCase("MoveConstruct/Heavy/Vector", n, n * sizeof(Heavy), [n] {
+        Vector<Heavy> src(n);
+        Vector<Heavy> dst(std::move(src));
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+    RunCase("MoveConstruct/Heavy/std", n, n * sizeof(Heavy), [n] {
+        std::vector<Heavy> src(n);
+        std::vector<Heavy> dst(std::move(src));
+        g_sink += reinterpret_cast<uintptr_t>(&dst[0]);
+    });
+}
+
+}  // namespace
+
+int main() {
+    std::printf("%-34s %16s %16s %12s\n", "case", "throughput", "bandwidth", "allocs/run");
+    BenchPushBack<Tick>("Tick", 1 << 20);
+    BenchPushBack<Heavy>("Heavy", 1 << 16);
+    BenchReserveFill(1 << 20);
+    BenchEmplaceMiddle(1 << 14);
+    BenchErase(1 << 14);
+    BenchCopyAssign(1 << 20);
+    BenchMoveConstruct(1 << 16);
+    return g_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "vector.h"
+
+#include <atomic>
+#include <cassert>
+#include <type_traits>
+#include <utility>
+
+//Lock-free буфер дозаписи для нескольких потоков-писателей.
+/*
+Фиксированная ёмкость поверх RawMemory и два атомарных счётчика. Писатель
+забирает слот одним fetch_add (lock-free, без CAS-циклов), конструирует
+элемент на месте и подтверждает его вторым fetch_add с release-семантикой.
+Это append-only буфер стадии сбора: много потоков складывают записи, затем
+производители останавливаются (join или барьер), и содержимое читается как
+обычный массив — begin()/end(). До затишья гарантируется только счётчик
+Size(), но не содержимое конкретных слотов: подтверждения приходят не по
+порядку.
+
+Конструкторы элементов обязаны быть noexcept: откат заявленного слота при
+исключении потребовал бы пер-слотовых флагов и разрушил бы lock-free
+свойство, а целевые типы (записи фиксированного размера) и так не бросают.
+
+Переполнение — штатный исход: TryEmplace возвращает nullptr, когда ёмкость
+исчерпана, и вызывающий сбрасывает буфер или берёт следующий.
+*/
+template <typename T>
+class ConcurrentAppendBuffer {
+public:
+    explicit ConcurrentAppendBuffer(size_t capacity)
+        : data_(capacity) {
+    }
+
+    ConcurrentAppendBuffer(const ConcurrentAppendBuffer&) = delete;
+    ConcurrentAppendBuffer& operator=(const ConcurrentAppendBuffer&) = delete;
+
+    ~ConcurrentAppendBuffer() {
+        std::destroy_n(data_.GetAddress(), ConstructedCount());
+    }
+
+    // Забирает слот и конструирует элемент. nullptr — буфер полон.
+    template <typename... Args>
+    T* TryEmplace(Args&&... args) noexcept {
+        static_assert(std::is_nothrow_constructible_v<T, Args&&...>,
+                      "конструктор элемента обязан быть noexcept");
+        const size_t slot = reserved_.fetch_add(1, std::memory_order_relaxed);
+        if (slot >= data_.Capacity()) {
+            // Счётчик остаётся насыщенным: ABA при обратном декременте
+            // опаснее, чем «перерасход» номеров слотов.
+            return nullptr;
+        }
+        T* ptr = new (data_ + slot) T(std::forward<Args>(args)...);
+        committed_.fetch_add(1, std::memory_order_release);
+        return ptr;
+    }
+
+    bool TryPush(const T& value) noexcept {
+        return TryEmplace(value) != nullptr;
+    }
+
+    bool TryPush(T&& value) noexcept {
+        return TryEmplace(std::move(value)) != nullptr;
+    }
+
+    // Число подтверждённых элементов. После остановки всех писателей —
+    // точное; во время записи слоты [0, Size()) ещё могут достраиваться.
+    size_t Size() const noexcept {
+        return committed_.load(std::memory_order_acquire);
+    }
+
+    size_t Capacity() const noexcept {
+        return data_.Capacity();
+    }
+
+    // Доступ к содержимому — только после затишья производителей.
+    T* begin() noexcept { return data_.GetAddress(); }
+    T* end() noexcept { return data_.GetAddress() + ConstructedCount(); }
+    const T* begin() const noexcept { return data_.GetAddress(); }
+    const T* end() const noexcept { return data_.GetAddress() + ConstructedCount(); }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < ConstructedCount());
+        return data_[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < ConstructedCount());
+        return data_[index];
+    }
+
+    /*
+    Запечатывает эпоху: отдаёт накопленное как обычный Vector<T> без единого
+    копирования — буфер целиком переезжает во владение вектора. После
+    передачи у ConcurrentAppendBuffer нулевая ёмкость (TryEmplace отвечает
+    nullptr); для следующего раунда конструируется новый буфер. Вызывать
+    только после затишья производителей.
+    */
+    Vector<T> TakeAsVector() noexcept {
+        const size_t count = ConstructedCount();
+        reserved_.store(0, std::memory_order_relaxed);
+        committed_.store(0, std::memory_order_relaxed);
+        return Vector<T>(std::move(data_), count);
+    }
+
+    // Опустошает буфер для следующего раунда. Только при остановленных
+    // писателях — это единственная не потокобезопасная операция.
+    void Reset() noexcept {
+        std::destroy_n(data_.GetAddress(), ConstructedCount());
+        reserved_.store(0, std::memory_order_relaxed);
+        committed_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    // Сконструированных слотов не может быть больше ёмкости, сколько бы
+    // заявок ни насытило reserved_.
+    size_t ConstructedCount() const noexcept {
+        const size_t reserved = reserved_.load(std::memory_order_acquire);
+        return reserved < data_.Capacity() ? reserved : data_.Capacity();
+    }
+
+    RawMemory<T> data_;
+    std::atomic<size_t> reserved_{0};
+    std::atomic<size_t> committed_{0};
+};
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+//Вектор с копированием при записи (copy-on-write).
+/*
+Обёртка для read-mostly данных, которые раздаются десяткам читателей:
+конфигурационные таблицы, справочники инструментов, снапшоты стакана.
+Snapshot() и копирование — O(1), это лишь ещё одна ссылка на общий буфер.
+Платит только писатель: первая мутация над разделяемым буфером снимает
+глубокую копию (detach), после чего правки идут по цене обычного Vector.
+
+Читающий интерфейс — константный (operator[], begin/end, Size); любой
+мутирующий метод проходит через Detach. Счётчик ссылок — атомарный
+(std::shared_ptr), поэтому снимки можно передавать между потоками; сам
+хэндл, как и любой контейнер, одним потоком пишется — другими не читается.
+*/
+template <typename T>
+class CowVector {
+public:
+    CowVector()
+        : data_(std::make_shared<Vector<T>>()) {
+    }
+
+    explicit CowVector(size_t size)
+        : data_(std::make_shared<Vector<T>>(size)) {
+    }
+
+    // Копия хэндла разделяет буфер — это и есть снимок.
+    CowVector(const CowVector&) = default;
+    CowVector& operator=(const CowVector&) = default;
+    CowVector(CowVector&&) noexcept = default;
+    CowVector& operator=(CowVector&&) noexcept = default;
+
+    // Явный O(1)-снимок текущего состояния.
+    CowVector Snapshot() const noexcept {
+        return *this;
+    }
+
+    size_t Size() const noexcept {
+        return data_->Size();
+    }
+
+    size_t Capacity() const noexcept {
+        return data_->Capacity();
+    }
+
+    // true, пока буфер никому больше не раздан (мутации бесплатны)
+    bool IsUnique() const noexcept {
+        return data_.use_count() == 1;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return (*data_)[index];
+    }
+
+    const T* begin() const noexcept {
+        return data_->begin();
+    }
+
+    const T* end() const noexcept {
+        return data_->end();
+    }
+
+    void PushBack(const T& value) {
+        Detach().PushBack(value);
+    }
+
+    void PushBack(T&& value) {
+        Detach().PushBack(std::move(value));
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        return Detach().EmplaceBack(std::forward<Args>(args)...);
+    }
+
+    // Не noexcept: перед удалением может потребоваться detach-копия.
+    void PopBack() {
+        Detach().PopBack();
+    }
+
+    void Resize(size_t new_size) {
+        Detach().Resize(new_size);
+    }
+
+    void Reserve(size_t new_capacity) {
+        Detach().Reserve(new_capacity);
+    }
+
+    // Запись по индексу — тоже мутация, со всеми её последствиями.
+    T& MutableAt(size_t index) {
+        return Detach()[index];
+    }
+
+    // Полный мутирующий доступ: один detach на серию правок.
+    Vector<T>& Mutable() {
+        return Detach();
+    }
+
+private:
+    // Отцепляет буфер от прочих владельцев: глубокая копия при use_count > 1.
+    Vector<T>& Detach() {
+        if (data_.use_count() > 1) {
+            data_ = std::make_shared<Vector<T>>(*data_);
+        }
+        return *data_;
+    }
+
+    std::shared_ptr<Vector<T>> data_;
+};
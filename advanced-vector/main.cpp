@@ -1,8 +1,25 @@
 #include "vector.h"
 
+#include "allocators.h"
+#include "concurrent_append_buffer.h"
+#include "cow_vector.h"
+#include "parallel_init.h"
+#include "segmented_vector.h"
+#include "small_vector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include "mmap_allocator.h"
+#include "serialize.h"
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cstdint>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
 namespace {
 
@@ -100,6 +117,47 @@ struct Obj {
 
 }  // namespace
 
+#if ADV_VECTOR_HAS_CONSTEXPR_ALLOC
+namespace {
+
+// Constexpr-поверхность проверяется самим компилятором: при сборке в C++20
+// эти функции исполняются в constant evaluation (в C++17 блок вырезан).
+constexpr int ConstexprGrowAndSum(int n) {
+    Vector<int> v;
+    for (int i = 1; i <= n; ++i) {
+        v.PushBack(i * i);  // рост с реаллокациями
+    }
+    Vector<int> copy(v);     // копирование
+    copy = v;                // копирующее присваивание
+    auto moved = std::move(copy);
+    moved.PopBack();
+    moved.Reserve(100);
+    moved.Resize(n);         // достройка нулём
+    int sum = 0;
+    for (int i = 0; i < n; ++i) {
+        sum += moved[i];
+    }
+    return sum + static_cast<int>(moved.Capacity());
+}
+
+// сумма квадратов 1..9 = 285, ёмкость после Reserve(100) = 100
+static_assert(ConstexprGrowAndSum(10) == 285 + 100);
+
+constexpr size_t ConstexprEmplaceBack() {
+    Vector<int> v;
+    v.Reserve(4);
+    v.EmplaceBackUnchecked(1);
+    v.EmplaceBack(2);
+    Vector<int> w(v);
+    w.Swap(v);
+    return v.Size() + w.Size() + static_cast<size_t>(v[1]);
+}
+
+static_assert(ConstexprEmplaceBack() == 2 + 2 + 2);
+
+}  // namespace
+#endif  // ADV_VECTOR_HAS_CONSTEXPR_ALLOC
+
 void Test1() {
     Obj::ResetCounters();
     const size_t SIZE = 100500;
@@ -380,6 +438,807 @@ void Test5() {
     }
 }
 
+void Test6() {
+    const int ID = 42;
+    {
+        // Пакетное дописывание делает не более одной реаллокации
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        Vector<Obj> src(100);
+        src[99].id = ID;
+        v.AppendRange(src.begin(), src.end());
+        assert(v.Size() == 100);
+        assert(v.Capacity() == 100);
+        assert(v[99].id == ID);
+        assert(Obj::num_copied == 100);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Дописывание вектора к самому себе безопасно при реаллокации
+        Vector<int> v;
+        for (int i = 0; i < 5; ++i) {
+            v.PushBack(i);
+        }
+        v.AppendRange(v);
+        assert(v.Size() == 10);
+        for (int i = 0; i < 5; ++i) {
+            assert(v[i] == i && v[i + 5] == i);
+        }
+    }
+    {
+        // Генератор вызывается по одному разу на элемент
+        Vector<Obj> v;
+        v.AppendGenerated(10, [](size_t i) {
+            return Obj(static_cast<int>(i));
+        });
+        assert(v.Size() == 10);
+        assert(v[9].id == 9);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test7() {
+    {
+        // ResizeForOverwrite не вызывает конструкторы тривиальных типов,
+        // но размер и ёмкость ведут себя как у Resize
+        Vector<int> v;
+        v.ResizeForOverwrite(1000);
+        assert(v.Size() == 1000);
+        assert(v.Capacity() == 1000);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        v.ResizeForOverwrite(10);
+        assert(v.Size() == 10);
+        assert(v[9] == 9);
+    }
+    {
+        // Нетривиальные типы конструируются по умолчанию
+        Obj::ResetCounters();
+        Vector<Obj> v;
+        v.ResizeForOverwrite(100);
+        assert(Obj::num_default_constructed == 100);
+        assert(Obj::GetAliveObjectCount() == 100);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // Прямая запись в запасную ёмкость
+        Vector<int> v;
+        v.Reserve(64);
+        assert(v.SpareCapacity() == 64);
+        int* out = v.SpareData();
+        for (int i = 0; i < 48; ++i) {
+            out[i] = i * 2;
+        }
+        v.CommitAppended(48);
+        assert(v.Size() == 48);
+        assert(v.SpareCapacity() == 16);
+        assert(v[47] == 94);
+    }
+}
+
+void Test8() {
+    // SmallVector: встроенный буфер, переезд в кучу, swap и move во всех
+    // комбинациях состояний — именно здесь прячутся ошибки переходов
+    Obj::ResetCounters();
+    {
+        SmallVector<Obj, 4> v;
+        assert(v.IsInline() && v.Capacity() == 4);
+        for (int i = 0; i < 4; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(v.IsInline() && v.Size() == 4);
+        v.EmplaceBack(4);  // переезд в кучу
+        assert(!v.IsInline() && v.Capacity() == 8);
+        assert(v[0].id == 0 && v[4].id == 4);
+        assert(Obj::GetAliveObjectCount() == 5);
+
+        SmallVector<Obj, 4> inl;
+        inl.EmplaceBack(100);
+        inl.Swap(v);  // смешанный swap: inline <-> heap
+        assert(inl.Size() == 5 && v.Size() == 1);
+        assert(inl[4].id == 4 && v[0].id == 100);
+
+        SmallVector<Obj, 4> heap_moved(std::move(inl));  // кража кучевого буфера
+        assert(!heap_moved.IsInline() && heap_moved.Size() == 5);
+        SmallVector<Obj, 4> inline_moved(std::move(v));  // поэлементный перенос
+        assert(inline_moved.IsInline() && inline_moved[0].id == 100);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // PushBack собственного элемента при полном встроенном буфере
+        SmallVector<int, 2> v;
+        v.PushBack(7);
+        v.PushBack(8);
+        v.PushBack(v[0]);
+        assert(v.Size() == 3 && v[2] == 7);
+    }
+}
+
+void Test9() {
+    // Аллокаторы: арена, пул, переработка буферов, выравнивание
+    {
+        BumpArena arena;
+        Vector<int, BumpArenaAllocator<int>> v{BumpArenaAllocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v[999] == 999);
+        auto moved = std::move(v);
+        assert(moved.Size() == 1000 && moved[0] == 0);
+    }
+    for (int round = 0; round < 10; ++round) {
+        Vector<std::string, PoolAllocator<std::string>> v;
+        for (int i = 0; i < 20; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        assert(v[19] == "19");
+    }
+    for (int round = 0; round < 10; ++round) {
+        Vector<std::string, RecyclingAllocator<std::string>> v;
+        for (int i = 0; i < 20; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        assert(v[19] == "19");
+    }
+    // Trim отпускает придержанные блоки; кэш продолжает работать после
+    BufferCache::ThreadLocal().Trim();
+    {
+        Vector<int, RecyclingAllocator<int>> v;
+        v.PushBack(1);
+        assert(v[0] == 1);
+    }
+    BufferCache::ThreadLocal().Trim();
+    {
+        Vector<float, AlignedAllocator<float, 64>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(reinterpret_cast<uintptr_t>(v.begin()) % 64 == 0);
+        }
+    }
+}
+
+void Test10() {
+    // SegmentedVector: стабильность адресов, границы сегментов, Flatten
+    Obj::ResetCounters();
+    {
+        SegmentedVector<Obj, 8> v;
+        v.EmplaceBack(1);
+        const Obj* first = &v[0];
+        for (int i = 2; i <= 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        assert(&v[0] == first && v[0].id == 1);  // элементы не переезжают
+        assert(Obj::GetAliveObjectCount() == 100);
+
+        for (int i = 0; i < 9; ++i) {
+            v.PopBack();  // через границу сегмента
+        }
+        assert(v.Size() == 91 && Obj::GetAliveObjectCount() == 91);
+
+        Vector<Obj> flat = v.Flatten();
+        assert(flat.Size() == 91 && flat.Capacity() == 91);
+        assert(flat[0].id == 1 && flat[90].id == 91);
+
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() > 0);
+        v.EmplaceBack(500);
+        assert(v[0].id == 500);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+void Test11() {
+    // CowVector: O(1)-снимки, отцепление при записи
+    CowVector<std::string> config;
+    for (int i = 0; i < 100; ++i) {
+        config.EmplaceBack(std::to_string(i));
+    }
+    auto snap = config.Snapshot();
+    assert(&snap[0] == &config[0]);  // буфер общий
+    assert(!config.IsUnique());
+    config.PushBack("new");          // первая мутация отцепляет писателя
+    assert(&snap[0] != &config[0]);
+    assert(snap.Size() == 100 && config.Size() == 101);
+    { auto dying = std::move(snap); }
+    assert(config.IsUnique());
+    const std::string* before = &config[0];
+    config.MutableAt(5) = "patched";  // без совладельцев — без копии
+    assert(&config[0] == before && config[5] == "patched");
+}
+
+void Test12() {
+    // ConcurrentAppendBuffer: многопоточная дозапись и передача в Vector
+    const int THREADS = 4;
+    const int PER_THREAD = 10000;
+    ConcurrentAppendBuffer<uint32_t> buf(THREADS * PER_THREAD);
+    {
+        std::thread workers[THREADS];
+        for (int t = 0; t < THREADS; ++t) {
+            workers[t] = std::thread([&buf, t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    buf.TryEmplace(static_cast<uint32_t>(t * PER_THREAD + i));
+                }
+            });
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+    assert(buf.Size() == size_t(THREADS) * PER_THREAD);
+    const uint32_t* raw = buf.begin();
+    Vector<uint32_t> v = buf.TakeAsVector();
+    assert(v.begin() == raw);  // передача без копирования
+    assert(buf.Capacity() == 0 && !buf.TryPush(0u));
+    Vector<char> seen(size_t(THREADS) * PER_THREAD);
+    for (uint32_t x : v) {
+        assert(seen[x] == 0);
+        seen[x] = 1;
+    }
+}
+
+void Test15() {
+    // Параллельная инициализация/разрушение: диапазон больше порога
+    // ForEachSlice, чтобы работа реально раскладывалась по потокам.
+    // Счётчики атомарные — конструкторы зовутся из нескольких потоков.
+    static std::atomic<int> ctors{0};
+    static std::atomic<int> dtors{0};
+    struct Counted {
+        long long payload = 42;
+        Counted() noexcept {
+            ctors.fetch_add(1, std::memory_order_relaxed);
+        }
+        ~Counted() {
+            dtors.fetch_add(1, std::memory_order_relaxed);
+        }
+    };
+    const size_t BIG = 1'000'000;  // ~15 слайсов по 64К
+    {
+        Vector<Counted> v;
+        ParallelResize(v, BIG, 4);
+        assert(v.Size() == BIG);
+        assert(ctors.load() == static_cast<int>(BIG));
+        assert(v[BIG - 1].payload == 42);
+        ParallelResize(v, 100, 4);  // сужение — параллельное разрушение
+        assert(v.Size() == 100);
+        assert(dtors.load() == static_cast<int>(BIG) - 100);
+        ParallelClear(v, 4);
+        assert(v.Size() == 0);
+        assert(dtors.load() == static_cast<int>(BIG));
+    }
+    assert(ctors.load() == dtors.load());
+    {
+        // маленький диапазон остаётся однопоточным, но проходит тот же код
+        Vector<int> v;
+        ParallelResize(v, 10);
+        assert(v.Size() == 10 && v[9] == 0);
+        ParallelClear(v);
+        assert(v.Size() == 0);
+    }
+}
+
+void Test17() {
+    {
+        Vector<std::string> v;
+        v.Reserve(100);
+        for (int i = 0; i < 50; ++i) {
+            v.EmplaceBack(std::to_string(i));
+        }
+        std::string arr[80];
+        for (int i = 0; i < 80; ++i) {
+            arr[i] = "a" + std::to_string(i);
+        }
+        // рост в пределах ёмкости: буфер переиспользуется
+        v.Assign(std::begin(arr), std::end(arr));
+        assert(v.Size() == 80 && v.Capacity() == 100);
+        assert(v[0] == "a0" && v[79] == "a79");
+        // усечение
+        v.Assign(size_t{5}, std::string("xx"));
+        assert(v.Size() == 5 && v.Capacity() == 100 && v[4] == "xx");
+        // значение из самого вектора
+        v.Assign(size_t{20}, v[2]);
+        assert(v.Size() == 20 && v[19] == "xx");
+        // рост сверх ёмкости: ровно один новый буфер точного размера
+        v.Assign(size_t{500}, std::string("y"));
+        assert(v.Size() == 500 && v.Capacity() == 500 && v[499] == "y");
+    }
+    {
+        // целочисленная пара обязана разрешаться в перегрузку (count, value)
+        Vector<int> v;
+        int count = 5;
+        int value = 7;
+        v.Assign(count, value);
+        assert(v.Size() == 5 && v[4] == 7);
+    }
+}
+
+void Test18() {
+    {
+        // Erase тривиального типа — memmove-ветка
+        Vector<int> v;
+        for (int i = 0; i < 10; ++i) {
+            v.PushBack(i);
+        }
+        auto it = v.Erase(v.begin() + 3);
+        assert(v.Size() == 9 && *it == 4 && v[8] == 9);
+        v.Erase(v.begin() + 8);  // последний элемент
+        assert(v.Size() == 8 && v[7] == 8);
+    }
+    Obj::ResetCounters();
+    {
+        // нетривиальный тип — move-уплотнение и разрушение хвоста
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Erase(v.begin());
+        assert(v.Size() == 9 && v[0].id == 1);
+        assert(Obj::GetAliveObjectCount() == 9);
+
+        auto it = v.EraseRange(v.begin() + 2, v.begin() + 7);
+        assert(v.Size() == 4 && it->id == 8);
+        assert(Obj::GetAliveObjectCount() == 4);
+
+        v.EraseRange(v.begin() + 1, v.begin() + 1);  // пустой диапазон — no-op
+        assert(v.Size() == 4);
+
+        const size_t removed = v.EraseIf([](const Obj& o) {
+            return o.id % 2 == 0;
+        });
+        assert(removed == 2 && v.Size() == 2);
+        assert(v[0].id == 1 && v[1].id == 9);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // EraseRange тривиального типа, хвост до самого конца
+        Vector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+        }
+        v.EraseRange(v.begin() + 10, v.end());
+        assert(v.Size() == 10 && v[9] == 9);
+        assert(v.EraseIf([](int x) { return x < 5; }) == 5);
+        assert(v.Size() == 5 && v[0] == 5);
+    }
+}
+
+void Test19() {
+    Obj::ResetCounters();
+    {
+        Vector<Obj> v;
+        for (int i = 0; i < 10; ++i) {
+            v.EmplaceBack(i);
+        }
+        auto it = v.SwapRemove(v.begin() + 3);  // последний встаёт в дыру
+        assert(v.Size() == 9 && it->id == 9);
+        v.SwapRemove(v.begin() + 8);            // удаление последнего
+        assert(v.Size() == 8);
+        assert(Obj::GetAliveObjectCount() == 8);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // переехавший с конца элемент тоже проверяется предикатом:
+        // подряд идущие совпадения в хвосте не пропускаются
+        Vector<int> v;
+        for (int x : {1, 8, 2, 8, 8, 8}) {
+            v.PushBack(x);
+        }
+        const size_t removed = v.SwapRemoveIf([](int x) {
+            return x == 8;
+        });
+        assert(removed == 4 && v.Size() == 2);
+        assert((v[0] == 1 && v[1] == 2) || (v[0] == 2 && v[1] == 1));
+        assert(v.SwapRemoveIf([](int) { return false; }) == 0);
+        assert(v.SwapRemoveIf([](int) { return true; }) == 2 && v.Size() == 0);
+    }
+}
+
+void Test20() {
+    {
+        // realloc-усечение тривиального типа
+        Vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.PushBack(i);
+        }
+        assert(v.Capacity() == 1024);
+        v.EraseRange(v.begin() + 100, v.end());
+        v.ShrinkToFit();
+        assert(v.Capacity() == 100 && v.Size() == 100 && v[99] == 99);
+        v.TrimCapacityTo(500);  // вверх не растит
+        assert(v.Capacity() == 100);
+    }
+    Obj::ResetCounters();
+    {
+        // перенос в меньший буфер для нетривиального типа + зажим к размеру
+        Vector<Obj> v;
+        for (int i = 0; i < 100; ++i) {
+            v.EmplaceBack(i);
+        }
+        v.Resize(10);
+        v.TrimCapacityTo(50);
+        assert(v.Capacity() == 50 && v.Size() == 10 && v[9].id == 9);
+        v.TrimCapacityTo(0);  // не ниже размера
+        assert(v.Capacity() == 10);
+        assert(Obj::GetAliveObjectCount() == 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // пустой вектор отпускает буфер целиком
+        Vector<int> v;
+        v.Reserve(4096);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0);
+    }
+}
+
+void Test21() {
+    {
+        // диапазонный конструктор: одна точная аллокация по forward-длине
+        int arr[100];
+        for (int i = 0; i < 100; ++i) {
+            arr[i] = i * 3;
+        }
+        Vector<int> v(std::begin(arr), std::end(arr));
+        assert(v.Size() == 100 && v.Capacity() == 100 && v[99] == 297);
+    }
+    {
+        // Vector(5, 7) — перегрузка заполнения, не генератор и не (size)
+        Vector<int> v(size_t{5}, 7);
+        assert(v.Size() == 5 && v.Capacity() == 5 && v[0] == 7 && v[4] == 7);
+    }
+    Obj::ResetCounters();
+    {
+        // генератор: ровно size вызовов, точная ёмкость
+        Vector<Obj> v(size_t{10}, [](size_t i) {
+            return Obj(static_cast<int>(i * 2));
+        });
+        assert(v.Size() == 10 && v.Capacity() == 10);
+        assert(v[0].id == 0 && v[9].id == 18);
+        assert(Obj::num_constructed_with_id == 10);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        // прежний Vector(size) не перехвачен новыми перегрузками
+        Vector<int> v(7);
+        assert(v.Size() == 7 && v.Capacity() == 7 && v[6] == 0);
+    }
+}
+
+void Test22() {
+    {
+        // тривиальный тип: memset/сплэт-ветки
+        Vector<int> v;
+        v.Resize(size_t{1000}, 5);
+        assert(v.Size() == 1000 && v[0] == 5 && v[999] == 5);
+        v.Resize(size_t{10}, 9);  // усечение: value не применяется
+        assert(v.Size() == 10 && v[9] == 5);
+        v.Resize(size_t{2000}, v[3]);  // значение изнутри + реаллокация
+        assert(v.Size() == 2000 && v[10] == 5 && v[1999] == 5);
+        v.Fill(8);
+        assert(v[0] == 8 && v[1999] == 8);
+        v.Fill(v[5]);  // Fill значением изнутри
+        assert(v[0] == 8 && v[1999] == 8);
+        // нулевой образ и байтовый тип — memset-ветки
+        Vector<unsigned char> b;
+        b.Resize(size_t{100000}, static_cast<unsigned char>(0x5A));
+        assert(b[0] == 0x5A && b[99999] == 0x5A);
+        b.Fill(static_cast<unsigned char>(0));
+        assert(b[0] == 0 && b[99999] == 0);
+    }
+    Obj::ResetCounters();
+    {
+        // нетривиальный тип идёт через uninitialized_fill_n / fill_n
+        Vector<Obj> v;
+        Obj proto(42);
+        v.Resize(size_t{50}, proto);
+        assert(v.Size() == 50 && v[0].id == 42 && v[49].id == 42);
+        Obj other(7);
+        v.Fill(other);
+        assert(v[0].id == 7 && v[49].id == 7);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+}
+
+namespace {
+
+// Нетривиально копируемая RAII-обёртка, помеченная тривиально перемещаемой —
+// ровно тот случай, ради которого типаж IsTriviallyRelocatable существует
+struct RelocHandle {
+    std::unique_ptr<int> res;
+
+    RelocHandle() = default;
+    explicit RelocHandle(int value)
+        : res(std::make_unique<int>(value)) {
+    }
+    RelocHandle(RelocHandle&&) noexcept = default;
+    RelocHandle& operator=(RelocHandle&&) noexcept = default;
+};
+
+}  // namespace
+
+template <>
+struct IsTriviallyRelocatable<RelocHandle> : std::true_type {};
+
+void Test25() {
+    static_assert(!std::is_trivially_copyable_v<RelocHandle>);
+    static_assert(kIsTriviallyRelocatable<RelocHandle>);
+    // пометка открывает и malloc/realloc-размещение буфера
+    static_assert(RawMemory<RelocHandle>::kCanReallocate);
+    // непомеченный unique_ptr остаётся на move-ветке
+    static_assert(!kIsTriviallyRelocatable<std::unique_ptr<int>>);
+    {
+        Vector<RelocHandle> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.EmplaceBack(i);  // рост через realloc, без move-конструкторов
+        }
+        for (int i = 0; i < 1000; i += 97) {
+            assert(*v[i].res == i);
+        }
+        v.Erase(v.begin() + 500);        // destroy + memmove-сдвиг
+        assert(v.Size() == 999 && *v[500].res == 501);
+        v.Emplace(v.begin() + 10, 4242);  // memmove-вставка в середину
+        assert(*v[10].res == 4242 && *v[11].res == 10);
+        v.EraseRange(v.begin() + 100, v.begin() + 900);
+        assert(v.Size() == 200 && *v[99].res == 98);
+    }  // деструкторы: ASan-прогон драйвера ловит утечки и двойные удаления
+}
+
+void Test24() {
+    {
+        // точный рост: ёмкость всегда равна размеру
+        Vector<int, std::allocator<int>, GrowthExact> v;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            assert(v.Capacity() == v.Size());
+        }
+        assert(v[99] == 99);
+    }
+    {
+        // полуторный рост: фиксируем первые ступени ёмкости
+        Vector<int, std::allocator<int>, GrowthOnePointFive> v;
+        size_t caps[8];
+        size_t n = 0;
+        size_t last = 0;
+        for (int i = 0; i < 30 && n < 8; ++i) {
+            v.PushBack(i);
+            if (v.Capacity() != last) {
+                last = v.Capacity();
+                caps[n++] = last;
+            }
+        }
+        assert(n == 8);
+        assert(caps[0] == 1 && caps[1] == 2 && caps[2] == 4 && caps[3] == 7);
+        assert(caps[4] == 11 && caps[5] == 17 && caps[6] == 26 && caps[7] == 40);
+    }
+    {
+        // постраничная квантизация: байтовый размер буфера кратен странице
+        Vector<int, std::allocator<int>, GrowthPageQuantized> v;
+        for (int i = 0; i < 10000; ++i) {
+            v.PushBack(i);
+        }
+        assert((v.Capacity() * sizeof(int)) % GrowthPageQuantized::kPageSize == 0);
+        assert(v[9999] == 9999);
+    }
+    {
+        // политика по умолчанию — прежнее удвоение
+        Vector<int> v;
+        v.PushBack(1);
+        v.PushBack(2);
+        v.PushBack(3);
+        assert(v.Capacity() == 4);
+    }
+}
+
+namespace {
+
+// Аллокатор с байтовым бюджетом: по исчерпании бросает bad_alloc —
+// так проверяются небросающие Try-обёртки
+template <typename T>
+struct BudgetAlloc {
+    using value_type = T;
+    static inline size_t budget = SIZE_MAX;
+
+    BudgetAlloc() = default;
+    template <typename U>
+    BudgetAlloc(const BudgetAlloc<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n * sizeof(T) > budget) {
+            throw std::bad_alloc();
+        }
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+};
+template <typename T, typename U>
+bool operator==(const BudgetAlloc<T>&, const BudgetAlloc<U>&) {
+    return true;
+}
+template <typename T, typename U>
+bool operator!=(const BudgetAlloc<T>&, const BudgetAlloc<U>&) {
+    return false;
+}
+
+}  // namespace
+
+void Test23() {
+    {
+        // успешный путь
+        Vector<std::string> v;
+        assert(v.TryReserve(100) && v.Capacity() == 100);
+        std::string* p = v.TryEmplaceBack(3, 'z');
+        assert(p != nullptr && *p == "zzz" && p == &v[0]);
+        assert(v.TryPushBack(std::string("a")));
+        assert(v.Size() == 2 && v[1] == "a");
+    }
+    {
+        // исчерпание бюджета превращается в false, вектор остаётся целым
+        BudgetAlloc<long long>::budget = 1024;
+        Vector<long long, BudgetAlloc<long long>> v;
+        size_t pushed = 0;
+        while (v.TryPushBack(static_cast<long long>(pushed))) {
+            ++pushed;
+        }
+        assert(pushed > 0 && v.Size() == pushed);
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(v[i] == static_cast<long long>(i));
+        }
+        const size_t cap = v.Capacity();
+        assert(!v.TryReserve(cap * 16));
+        assert(v.Capacity() == cap);     // отказ не меняет состояние
+        assert(v.TryReserve(cap));       // no-op — успех
+        BudgetAlloc<long long>::budget = SIZE_MAX;
+    }
+}
+
+namespace {
+
+// Stateful-аллокатор для проверки переноса аллокаторов: POCMA включён,
+// POCS намеренно выключен — буфер обязан приезжать вместе со своим
+// аллокатором, а не обмениваться без него. Считает освобождения по id.
+template <typename T>
+struct StatefulAlloc {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::false_type;
+
+    static inline int frees_by_id[8] = {};
+
+    int id = 0;
+    StatefulAlloc() = default;
+    explicit StatefulAlloc(int id) : id(id) {}
+    template <typename U>
+    StatefulAlloc(const StatefulAlloc<U>& other) : id(other.id) {}
+
+    T* allocate(size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* ptr, size_t n) {
+        ++frees_by_id[id];
+        std::allocator<T>().deallocate(ptr, n);
+    }
+};
+template <typename T, typename U>
+bool operator==(const StatefulAlloc<T>& lhs, const StatefulAlloc<U>& rhs) {
+    return lhs.id == rhs.id;
+}
+template <typename T, typename U>
+bool operator!=(const StatefulAlloc<T>& lhs, const StatefulAlloc<U>& rhs) {
+    return lhs.id != rhs.id;
+}
+
+}  // namespace
+
+void Test16() {
+    using V = Vector<std::string, StatefulAlloc<std::string>>;
+    {
+        // move-присваивание при POCMA без POCS и неравных аллокаторах:
+        // буфер переезжает вместе со своим аллокатором
+        V a{StatefulAlloc<std::string>(1)};
+        for (int i = 0; i < 100; ++i) {
+            a.EmplaceBack(std::to_string(i));
+        }
+        V b{StatefulAlloc<std::string>(2)};
+        b.EmplaceBack("b");
+        const int frees2_before = StatefulAlloc<std::string>::frees_by_id[2];
+        b = std::move(a);
+        assert(b.GetAllocator().id == 1);  // аллокатор приехал с буфером
+        assert(StatefulAlloc<std::string>::frees_by_id[2] == frees2_before + 1);
+        assert(b.Size() == 100 && b[99] == "99");
+    }  // деструкторы освобождают каждый буфер его собственным аллокатором
+    {
+        // копирующее присваивание с POCCA: старый буфер освобождён прежним
+        // аллокатором, после присваивания носитель — аллокатор источника
+        V a{StatefulAlloc<std::string>(3)};
+        for (int i = 0; i < 50; ++i) {
+            a.EmplaceBack(std::to_string(i));
+        }
+        V b{StatefulAlloc<std::string>(4)};
+        b.EmplaceBack("b");
+        const int frees3_before = StatefulAlloc<std::string>::frees_by_id[3];
+        a = b;
+        assert(a.GetAllocator().id == 4);
+        assert(StatefulAlloc<std::string>::frees_by_id[3] == frees3_before + 1);
+        assert(a.Size() == 1 && a[0] == "b");
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+void Test13() {
+    // serialize.h: WriteSized/ReadSized через pipe без копий
+    struct Rec {
+        int a;
+        int b;
+    };
+    Vector<Rec> src;
+    for (int i = 0; i < 1000; ++i) {
+        src.PushBack(Rec{i, ~i});
+    }
+    int p[2];
+    [[maybe_unused]] int rc = pipe(p);
+    assert(rc == 0);
+    assert(WriteSized(p[1], src));  // 8 КиБ — помещается в буфер pipe
+    close(p[1]);
+    Vector<Rec> dst;
+    assert(ReadSized(p[0], dst));
+    close(p[0]);
+    assert(dst.Size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        assert(dst[i].a == i && dst[i].b == ~i);
+    }
+    iovec io = AsIovec(src);
+    assert(io.iov_len == 1000 * sizeof(Rec) && io.iov_base == src.begin());
+}
+void Test14() {
+    // mmap-аллокатор: рост с постраничной ёмкостью
+    {
+        Vector<long long, MmapAllocator<long long>, GrowthPageQuantized> v;
+        for (int i = 0; i < 100000; ++i) {
+            v.PushBack(i);
+        }
+        assert((v.Capacity() * sizeof(long long)) % 4096 == 0);
+        for (int i = 0; i < 100000; i += 997) {
+            assert(v[i] == i);
+        }
+        auto moved = std::move(v);
+        assert(moved.Size() == 100000 && moved[99999] == 99999);
+    }
+    // персистентный вектор: create -> fill -> sync -> reopen -> append -> reopen
+    struct Rec {
+        double price;
+        long long ts;
+    };
+    const char* path = "/tmp/advanced_vector_test14.bin";
+    unlink(path);
+    {
+        auto v = OpenPersistentVector<Rec>(path);
+        assert(v.Size() == 0);
+        for (int i = 0; i < 10000; ++i) {
+            v.PushBack(Rec{i * 0.5, i});
+        }
+        assert(PersistentSync(v));
+    }
+    {
+        auto v = OpenPersistentVector<Rec>(path);
+        assert(v.Size() == 10000);
+        for (int i = 0; i < 10000; i += 313) {
+            assert(v[i].ts == i && v[i].price == i * 0.5);
+        }
+        v.PushBack(Rec{-1.0, -1});
+        assert(PersistentSync(v));
+    }
+    {
+        auto v = OpenPersistentVector<Rec>(path);
+        assert(v.Size() == 10001);
+        assert(v[10000].ts == -1 && v[0].ts == 0);
+    }
+    unlink(path);
+}
+#endif
+
 int main() {
     try {
         Test1();
@@ -387,6 +1246,28 @@ int main() {
         Test3();
         Test4();
         Test5();
+        Test6();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+#if defined(__unix__) || defined(__APPLE__)
+        Test13();
+        Test14();
+#endif
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
     }
@@ -0,0 +1,203 @@
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "mmap_allocator.h доступен только на POSIX-системах"
+#endif
+
+#include "vector.h"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//Аллокатор поверх mmap с опциональными огромными страницами.
+/*
+Буфер берётся напрямую у ядра анонимным приватным отображением, минуя malloc:
+ни блокировок аллокатора, ни его метаданных, а страницы возвращаются системе
+сразу при munmap. Размер округляется до целых страниц — с политикой
+GrowthPageQuantized (vector.h) отображение используется без хвостов.
+
+Вторым параметром включаются прозрачные огромные страницы: при HugePages =
+true свежему отображению даётся подсказка MADV_HUGEPAGE (Linux; на прочих
+системах подсказка молча опускается). Для многогигабайтных векторов это
+сокращает промахи TLB в разы.
+
+Подключение: Vector<T, MmapAllocator<T>> или
+Vector<T, MmapAllocator<T, true>, GrowthPageQuantized> для огромных страниц.
+*/
+template <typename T, bool HugePages = false>
+class MmapAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    MmapAllocator() noexcept = default;
+
+    template <typename U>
+    MmapAllocator(const MmapAllocator<U, HugePages>&) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = RoundToPages(n * sizeof(T));
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+#if defined(MADV_HUGEPAGE)
+        if constexpr (HugePages) {
+            // Подсказка, а не требование: при отказе ядра работаем
+            // на обычных страницах.
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+        }
+#endif
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        munmap(ptr, RoundToPages(n * sizeof(T)));
+    }
+
+private:
+    static size_t RoundToPages(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return ((bytes + page - 1) / page) * page;
+    }
+};
+
+template <typename T, typename U, bool H>
+bool operator==(const MmapAllocator<T, H>&, const MmapAllocator<U, H>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U, bool H>
+bool operator!=(const MmapAllocator<T, H>&, const MmapAllocator<U, H>&) noexcept {
+    return false;
+}
+
+//Аллокатор поверх именованного файла: персистентный вектор.
+/*
+Буфер — разделяемое (MAP_SHARED) отображение файла: записанные элементы
+лежат прямо в странице файла, и после PersistentSync вектор можно закрыть
+и открыть заново без какой-либо сериализации — байты файла и есть элементы.
+Только для тривиально копируемых типов.
+
+Аллокатор не имеет конструктора по умолчанию — вектор создаётся через
+OpenPersistentVector(path), который выводит логический размер из размера
+файла. Файл при allocate подращивается ftruncate'ом до размера отображения;
+PersistentSync усекает его обратно до ровно Size() * sizeof(T) байт, чтобы
+повторное открытие увидело именно столько элементов.
+*/
+template <typename T>
+class FileMmapAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    explicit FileMmapAllocator(const char* path)
+        : fd_(OpenFd(path)) {
+    }
+
+    template <typename U>
+    FileMmapAllocator(const FileMmapAllocator<U>& other) noexcept
+        : fd_(other.SharedFd()) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = RoundToPages(n * sizeof(T));
+        // Файл должен покрывать отображение, иначе запись упрётся в SIGBUS.
+        if (FileSizeBytes() < bytes && ftruncate(*fd_, static_cast<off_t>(bytes)) != 0) {
+            throw std::bad_alloc();
+        }
+        void* ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, *fd_, 0);
+        if (ptr == MAP_FAILED) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        munmap(ptr, RoundToPages(n * sizeof(T)));
+    }
+
+    size_t FileSizeBytes() const noexcept {
+        struct stat st;
+        return fstat(*fd_, &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+    }
+
+    int Fd() const noexcept {
+        return *fd_;
+    }
+
+    const std::shared_ptr<int>& SharedFd() const noexcept {
+        return fd_;
+    }
+
+private:
+    static std::shared_ptr<int> OpenFd(const char* path) {
+        const int fd = open(path, O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("FileMmapAllocator: не удалось открыть файл");
+        }
+        return std::shared_ptr<int>(new int(fd), [](int* p) {
+            close(*p);
+            delete p;
+        });
+    }
+
+    static size_t RoundToPages(size_t bytes) noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return ((bytes + page - 1) / page) * page;
+    }
+
+    std::shared_ptr<int> fd_;
+};
+
+template <typename T, typename U>
+bool operator==(const FileMmapAllocator<T>& lhs, const FileMmapAllocator<U>& rhs) noexcept {
+    return lhs.Fd() == rhs.Fd();
+}
+
+template <typename T, typename U>
+bool operator!=(const FileMmapAllocator<T>& lhs, const FileMmapAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// Открывает (или создаёт) файл как персистентный вектор: содержимое файла
+// становится элементами без десериализации, логический размер выводится из
+// размера файла.
+template <typename T>
+Vector<T, FileMmapAllocator<T>> OpenPersistentVector(const char* path) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "персистентный вектор — только для тривиально копируемых типов");
+    FileMmapAllocator<T> alloc(path);
+    const size_t count = alloc.FileSizeBytes() / sizeof(T);
+    Vector<T, FileMmapAllocator<T>> v(alloc);
+    v.Reserve(count);
+    v.CommitAppended(count);
+    return v;
+}
+
+// Финализирует партию: ужимает отображение до точного размера, сбрасывает
+// страницы на диск и усекает файл до ровно Size() * sizeof(T) байт.
+// false при ошибке ввода-вывода (errno выставлен).
+template <typename T>
+bool PersistentSync(Vector<T, FileMmapAllocator<T>>& v) {
+    v.ShrinkToFit();
+    const size_t bytes = v.Size() * sizeof(T);
+    if (bytes != 0 && msync(v.begin(), bytes, MS_SYNC) != 0) {
+        return false;
+    }
+    return ftruncate(v.GetAllocator().Fd(), static_cast<off_t>(bytes)) == 0;
+}
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+
+//Параллельная инициализация и разрушение огромных буферов.
+/*
+Для векторов в сотни миллионов элементов однопоточный проход конструкторов
+(или memset при value-инициализации) упирается в один канал памяти. Функции
+ниже нарезают диапазон на равные куски и прогоняют их пулом std::thread.
+
+Допускаются только типы, у которых конструктор по умолчанию не бросает:
+откат наполовину сконструированного буфера из нескольких потоков не
+реализуем без существенного усложнения, а для целевых типов (PODы, счётчики,
+простые агрегаты) исключений и так нет. Деструкторы noexcept по умолчанию.
+
+Состыковка с Vector — через интерфейс запасной ёмкости:
+
+    Vector<Record> v;
+    v.Reserve(n);
+    ParallelUninitializedValueConstruct(v.SpareData(), n);
+    v.CommitAppended(n);
+
+или одной функцией ParallelResize(v, n).
+*/
+
+inline size_t ParallelDefaultThreads() noexcept {
+    const unsigned hw = std::thread::hardware_concurrency();
+    return hw != 0 ? hw : 1;
+}
+
+namespace detail {
+
+// Меньше этого объёма на поток распараллеливание не окупает запуск потоков.
+inline constexpr size_t kMinElementsPerThread = 64 * 1024;
+
+// Больше рабочих просто не помещается в массив ниже; заодно это разумный
+// потолок выигрыша на каналах памяти.
+inline constexpr size_t kMaxWorkers = 64;
+
+// Нарезает [0, count) на слайсы и исполняет fn(begin, len) в threads потоках.
+// Последний слайс исполняется в вызывающем потоке.
+template <typename Fn>
+void ForEachSlice(size_t count, size_t threads, Fn fn) {
+    if (threads > count / kMinElementsPerThread) {
+        threads = count / kMinElementsPerThread;
+    }
+    if (threads > kMaxWorkers) {
+        threads = kMaxWorkers;
+    }
+    if (threads <= 1) {
+        fn(size_t{0}, count);
+        return;
+    }
+    const size_t per_thread = count / threads;
+    std::thread workers[kMaxWorkers];
+    for (size_t i = 0; i + 1 < threads; ++i) {
+        workers[i] = std::thread(fn, i * per_thread, per_thread);
+    }
+    fn((threads - 1) * per_thread, count - (threads - 1) * per_thread);
+    for (size_t i = 0; i + 1 < threads; ++i) {
+        workers[i].join();
+    }
+}
+
+}  // namespace detail
+
+template <typename T>
+void ParallelUninitializedValueConstruct(T* first, size_t count,
+                                         size_t threads = ParallelDefaultThreads()) {
+    static_assert(std::is_nothrow_default_constructible_v<T>,
+                  "параллельная инициализация требует не бросающий конструктор");
+    detail::ForEachSlice(count, threads, [first](size_t begin, size_t len) {
+        std::uninitialized_value_construct_n(first + begin, len);
+    });
+}
+
+template <typename T>
+void ParallelUninitializedFill(T* first, size_t count, const T& value,
+                               size_t threads = ParallelDefaultThreads()) {
+    static_assert(std::is_nothrow_copy_constructible_v<T>,
+                  "параллельное заполнение требует не бросающее копирование");
+    detail::ForEachSlice(count, threads, [first, &value](size_t begin, size_t len) {
+        std::uninitialized_fill_n(first + begin, len, value);
+    });
+}
+
+template <typename T>
+void ParallelDestroy(T* first, size_t count,
+                     size_t threads = ParallelDefaultThreads()) {
+    if constexpr (std::is_trivially_destructible_v<T>) {
+        (void)first; (void)count; (void)threads;
+    } else {
+        detail::ForEachSlice(count, threads, [first](size_t begin, size_t len) {
+            std::destroy_n(first + begin, len);
+        });
+    }
+}
+
+// Параллельный аналог Vector::Resize в сторону увеличения.
+template <typename T, typename Alloc, typename Growth>
+void ParallelResize(Vector<T, Alloc, Growth>& v, size_t new_size,
+                    size_t threads = ParallelDefaultThreads()) {
+    if (new_size <= v.Size()) {
+        ParallelDestroy(v.begin() + new_size, v.Size() - new_size, threads);
+        v.DiscardDestroyed(v.Size() - new_size);
+        return;
+    }
+    v.Reserve(new_size);
+    ParallelUninitializedValueConstruct(v.SpareData(), new_size - v.Size(), threads);
+    v.CommitAppended(new_size - v.Size());
+}
+
+// Параллельно разрушает все элементы вектора; память остаётся за вектором.
+template <typename T, typename Alloc, typename Growth>
+void ParallelClear(Vector<T, Alloc, Growth>& v,
+                   size_t threads = ParallelDefaultThreads()) {
+    ParallelDestroy(v.begin(), v.Size(), threads);
+    v.DiscardDestroyed(v.Size());
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+//Сегментированный вектор: рост без реаллокации.
+/*
+Хранилище — цепочка сегментов фиксированного размера; при росте добавляется
+новый сегмент, а существующие элементы никогда не переезжают. Это убирает
+два эффекта обычного вектора: всплеск задержки на O(n)-реаллокации посреди
+горячего пути и инвалидацию указателей/ссылок на элементы (итераторы и
+ссылки стабильны, пока элемент не удалён с конца).
+
+Плата — второй переход по указателю при индексации: [i] разлагается в
+segments[i >> shift][i & mask], поэтому SegmentSize обязан быть степенью
+двойки. Для последовательного обхода компилятор поднимает выбор сегмента из
+внутреннего цикла, и разница с плоским вектором почти исчезает.
+
+Справочник сегментов — обычный Vector<RawMemory<T>>: его реаллокация
+перемещает лишь указатели на сегменты, а не элементы.
+*/
+template <typename T, size_t SegmentSize = 1024>
+class SegmentedVector {
+    static_assert(SegmentSize > 0 && (SegmentSize & (SegmentSize - 1)) == 0,
+                  "размер сегмента должен быть степенью двойки");
+
+    static constexpr size_t Log2(size_t x) noexcept {
+        size_t r = 0;
+        while (x > 1) {
+            x >>= 1;
+            ++r;
+        }
+        return r;
+    }
+
+    static constexpr size_t kShift = Log2(SegmentSize);
+    static constexpr size_t kMask = SegmentSize - 1;
+
+    template <bool IsConst>
+    class BasicIterator {
+        using Owner = std::conditional_t<IsConst, const SegmentedVector, SegmentedVector>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() = default;
+
+        BasicIterator(Owner* owner, size_t index) noexcept
+            : owner_(owner)
+            , index_(index) {
+        }
+
+        reference operator*() const noexcept {
+            return (*owner_)[index_];
+        }
+
+        pointer operator->() const noexcept {
+            return std::addressof(**this);
+        }
+
+        BasicIterator& operator++() noexcept {
+            ++index_;
+            return *this;
+        }
+
+        BasicIterator operator++(int) noexcept {
+            BasicIterator copy(*this);
+            ++index_;
+            return copy;
+        }
+
+        bool operator==(const BasicIterator& rhs) const noexcept {
+            return index_ == rhs.index_;
+        }
+
+        bool operator!=(const BasicIterator& rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+    private:
+        Owner* owner_ = nullptr;
+        size_t index_ = 0;
+    };
+
+public:
+    using iterator = BasicIterator<false>;
+    using const_iterator = BasicIterator<true>;
+
+    SegmentedVector() = default;
+
+    SegmentedVector(const SegmentedVector& other) {
+        try {
+            for (const T& value : other) {
+                PushBack(value);
+            }
+        } catch (...) {
+            // Деструктор недостроенного объекта не вызывается — уже
+            // скопированные элементы прибираем сами, иначе сегменты
+            // освободятся без вызова их деструкторов.
+            Clear();
+            throw;
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : segments_(std::move(other.segments_))
+        , size_(std::exchange(other.size_, 0)) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other) {
+        if (this != &other) {
+            SegmentedVector copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept {
+        Swap(other);
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return segments_.Size() * SegmentSize;
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        segments_.Swap(other.segments_);
+        std::swap(size_, other.size_);
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SegmentedVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return segments_[index >> kShift][index & kMask];
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ == Capacity()) {
+            segments_.EmplaceBack(RawMemory<T>(SegmentSize));
+        }
+        T* slot = segments_[size_ >> kShift] + (size_ & kMask);
+        T* result = new (slot) T(std::forward<Args>(args)...);
+        ++size_;
+        return *result;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            --size_;
+            std::destroy_at(segments_[size_ >> kShift] + (size_ & kMask));
+        }
+    }
+
+    // Разрушает элементы; сегменты остаются под повторное наполнение.
+    void Clear() noexcept {
+        for (size_t i = size_; i > 0; --i) {
+            std::destroy_at(segments_[(i - 1) >> kShift] + ((i - 1) & kMask));
+        }
+        size_ = 0;
+    }
+
+    // Сшивает партию в сплошной Vector<T>: одна точная аллокация и
+    // посегментное блочное копирование (для тривиально копируемых типов —
+    // memcpy на сегмент). Типичный финал стадии накопления.
+    Vector<T> Flatten() const {
+        Vector<T> result;
+        result.Reserve(size_);
+        for (size_t seg = 0; seg * SegmentSize < size_; ++seg) {
+            const size_t begin = seg * SegmentSize;
+            const size_t len = std::min(SegmentSize, size_ - begin);
+            result.AppendRange(segments_[seg].GetAddress(),
+                               segments_[seg].GetAddress() + len);
+        }
+        return result;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size_); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+private:
+    Vector<RawMemory<T>> segments_;
+    size_t size_ = 0;
+};
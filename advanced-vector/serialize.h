@@ -0,0 +1,115 @@
+#pragma once
+
+#if !defined(__unix__) && !defined(__APPLE__)
+#error "serialize.h использует POSIX readv/writev"
+#endif
+
+#include "vector.h"
+
+#include <cstdint>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+//Бинарная сериализация без промежуточных копий.
+/*
+Для тривиально копируемых элементов буфер вектора и есть его сетевое/дисковое
+представление: WriteTo отдаёт его ядру напрямую, ReadFrom читает с файлового
+дескриптора сразу в хранилище вектора (через ResizeForOverwrite, то есть без
+предварительного обнуления). AsIovec экспортирует буфер как iovec — несколько
+векторов и заголовков собираются в один writev без единой склейки в памяти.
+
+Байтовый порядок — нативный: формат предназначен для однородных машин
+(шард-узлы, снапшоты на локальный диск), а не для внешнего обмена.
+*/
+
+template <typename T, typename Alloc, typename Growth>
+iovec AsIovec(const Vector<T, Alloc, Growth>& v) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "сериализуются только тривиально копируемые элементы");
+    return {const_cast<T*>(v.begin()), v.Size() * sizeof(T)};
+}
+
+// Дописывает весь буфер вектора в fd. false при ошибке записи (errno
+// выставлен); частичные записи дозаписываются внутри.
+template <typename T, typename Alloc, typename Growth>
+bool WriteTo(int fd, const Vector<T, Alloc, Growth>& v) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "сериализуются только тривиально копируемые элементы");
+    const char* ptr = reinterpret_cast<const char*>(v.begin());
+    size_t left = v.Size() * sizeof(T);
+    while (left > 0) {
+        const ssize_t n = write(fd, ptr, left);
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        left -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Читает count элементов из fd прямо в буфер вектора, затирая его прежнее
+// содержимое. false при ошибке чтения или преждевременном EOF.
+template <typename T, typename Alloc, typename Growth>
+bool ReadFrom(int fd, Vector<T, Alloc, Growth>& v, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "сериализуются только тривиально копируемые элементы");
+    v.ResizeForOverwrite(count);
+    char* ptr = reinterpret_cast<char*>(v.begin());
+    size_t left = count * sizeof(T);
+    while (left > 0) {
+        const ssize_t n = read(fd, ptr, left);
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        left -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+// Запись с префиксом длины: заголовок и буфер уходят одним writev —
+// scatter-gather вместо склейки в промежуточный буфер.
+template <typename T, typename Alloc, typename Growth>
+bool WriteSized(int fd, const Vector<T, Alloc, Growth>& v) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "сериализуются только тривиально копируемые элементы");
+    uint64_t count = v.Size();
+    iovec parts[2] = {{&count, sizeof(count)}, AsIovec(v)};
+    size_t left = sizeof(count) + parts[1].iov_len;
+    while (left > 0) {
+        const ssize_t n = writev(fd, parts, 2);
+        if (n <= 0) {
+            return false;
+        }
+        left -= static_cast<size_t>(n);
+        // Частичная запись: сдвигаем iovec на только что ушедшие байты.
+        size_t done = static_cast<size_t>(n);
+        for (iovec& part : parts) {
+            const size_t skip = std::min(done, part.iov_len);
+            part.iov_base = static_cast<char*>(part.iov_base) + skip;
+            part.iov_len -= skip;
+            done -= skip;
+        }
+    }
+    return true;
+}
+
+// Парное чтение: префикс длины, затем данные сразу в буфер вектора.
+template <typename T, typename Alloc, typename Growth>
+bool ReadSized(int fd, Vector<T, Alloc, Growth>& v) {
+    uint64_t count = 0;
+    char* ptr = reinterpret_cast<char*>(&count);
+    size_t left = sizeof(count);
+    while (left > 0) {
+        const ssize_t n = read(fd, ptr, left);
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        left -= static_cast<size_t>(n);
+    }
+    return ReadFrom(fd, v, static_cast<size_t>(count));
+}
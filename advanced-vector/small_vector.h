@@ -0,0 +1,243 @@
+#pragma once
+
+#include "vector.h"
+
+#include <cassert>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//Вектор с малым буфером (small buffer optimization).
+/*
+До N элементов включительно SmallVector хранит данные во встроенном
+выровненном буфере внутри самого объекта — ни одного обращения к куче и ни
+одного разыменования лишнего указателя. Начиная с N + 1 элементов контейнер
+прозрачно переезжает в RawMemory и дальше ведёт себя как Vector. Обратно во
+встроенный буфер контейнер не возвращается: это избавляет от осцилляций
+вокруг границы N.
+
+Move-семантика зависит от состояния: кучевой буфер крадётся за O(1),
+встроенный переносится поэлементно (для тривиально копируемых типов — одним
+memcpy).
+*/
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "встроенный буфер должен вмещать хотя бы один элемент");
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() = default;
+
+    explicit SmallVector(size_t size) {
+        Reserve(size);
+        std::uninitialized_value_construct_n(Data(), size);
+        size_ = size;
+    }
+
+    SmallVector(const SmallVector& other) {
+        Reserve(other.size_);
+        std::uninitialized_copy_n(other.Data(), other.size_, Data());
+        size_ = other.size_;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        TakeContent(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            if (other.size_ <= Capacity()) {
+                // Память уже есть — переиспользуем её, как Vector::operator=.
+                if (size_ <= other.size_) {
+                    std::copy(other.Data(), other.Data() + size_, Data());
+                    std::uninitialized_copy_n(other.Data() + size_, other.size_ - size_,
+                                              Data() + size_);
+                } else {
+                    std::copy(other.Data(), other.Data() + other.size_, Data());
+                    std::destroy_n(Data() + other.size_, size_ - other.size_);
+                }
+                size_ = other.size_;
+            } else {
+                SmallVector other_copy(other);
+                *this = std::move(other_copy);
+            }
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            std::destroy_n(Data(), size_);
+            size_ = 0;
+            heap_ = RawMemory<T>();
+            TakeContent(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        std::destroy_n(Data(), size_);
+    }
+
+    iterator begin() noexcept { return Data(); }
+    iterator end() noexcept { return Data() + size_; }
+    const_iterator begin() const noexcept { return Data(); }
+    const_iterator end() const noexcept { return Data() + size_; }
+    const_iterator cbegin() const noexcept { return Data(); }
+    const_iterator cend() const noexcept { return Data() + size_; }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return IsInline() ? N : heap_.Capacity();
+    }
+
+    // true, пока данные лежат во встроенном буфере
+    bool IsInline() const noexcept {
+        return heap_.GetAddress() == nullptr;
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        return const_cast<SmallVector&>(*this)[index];
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return Data()[index];
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        RawMemory<T> new_data(new_capacity);
+        RelocateN(Data(), size_, new_data.GetAddress());
+        if constexpr (!kIsTriviallyRelocatable<T>) {
+            std::destroy_n(Data(), size_);
+        }
+        heap_.Swap(new_data);
+    }
+
+    void Resize(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(Data() + new_size, size_ - new_size);
+        } else {
+            if (new_size > Capacity()) {
+                Reserve(std::max(Capacity() * 2, new_size));
+            }
+            std::uninitialized_value_construct_n(Data() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    void PopBack() noexcept {
+        if (size_ > 0) {
+            std::destroy_at(Data() + size_ - 1);
+            --size_;
+        }
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), size_);
+        size_ = 0;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        T* result = nullptr;
+        if (size_ == Capacity()) {
+            // Как и в Vector, новый элемент конструируется до переноса старых:
+            // args могут ссылаться на элемент этого же контейнера.
+            RawMemory<T> new_data(Capacity() * 2);
+            result = new (new_data + size_) T(std::forward<Args>(args)...);
+            try {
+                RelocateN(Data(), size_, new_data.GetAddress());
+            } catch (...) {
+                std::destroy_at(result);
+                throw;
+            }
+            if constexpr (!kIsTriviallyRelocatable<T>) {
+                std::destroy_n(Data(), size_);
+            }
+            heap_.Swap(new_data);
+        } else {
+            result = new (Data() + size_) T(std::forward<Args>(args)...);
+        }
+        ++size_;
+        return *result;
+    }
+
+    void Swap(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (!IsInline() && !other.IsInline()) {
+            heap_.Swap(other.heap_);
+            std::swap(size_, other.size_);
+            return;
+        }
+        // Хотя бы один контейнер во встроенном буфере — обмен через перемещение.
+        SmallVector tmp(std::move(*this));
+        *this = std::move(other);
+        other = std::move(tmp);
+    }
+
+private:
+    T* Data() noexcept {
+        return IsInline() ? InlineData() : heap_.GetAddress();
+    }
+
+    const T* Data() const noexcept {
+        return const_cast<SmallVector&>(*this).Data();
+    }
+
+    T* InlineData() noexcept {
+        return reinterpret_cast<T*>(inline_buf_);
+    }
+
+    // Забирает содержимое other; собственное хранилище должно быть пустым.
+    void TakeContent(SmallVector& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.IsInline()) {
+            RelocateN(other.Data(), other.size_, InlineData());
+            if constexpr (!kIsTriviallyRelocatable<T>) {
+                std::destroy_n(other.Data(), other.size_);
+            }
+            size_ = std::exchange(other.size_, 0);
+        } else {
+            heap_ = std::move(other.heap_);
+            size_ = std::exchange(other.size_, 0);
+        }
+    }
+
+    // Перенос в сырую память: memcpy для тривиально копируемых типов,
+    // иначе перемещение (или копирование, если перемещение может бросить).
+    static void RelocateN(T* from, size_t count, T* to) {
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (count != 0) {
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from),
+                            count * sizeof(T));
+            }
+        } else if constexpr (kAssumeNothrowElements
+                             || std::is_nothrow_move_constructible_v<T>
+                             || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, count, to);
+        } else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    alignas(T) unsigned char inline_buf_[N * sizeof(T)];
+    RawMemory<T> heap_;
+    size_t size_ = 0;
+};
@@ -1,28 +1,289 @@
 #pragma once
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 #include <algorithm>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <iterator>
+#include <type_traits>
 
-//Отдельный класс-обёртка, управляющий сырой памятью.
+#include <cstdint>
+
+#include <atomic>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//Потоковый перенос мимо кэша.
+/*
+Обычный memcpy при реаллокации многогигабайтного буфера вытесняет из LLC
+рабочий набор всего процесса, хотя сами переносимые байты больше никому в
+кэше не нужны. Начиная с kStreamingCopyBytes перенос идёт non-temporal
+store'ами (_mm_stream_si128): строки уезжают в память мимо кэша, а sfence в
+конце упорядочивает их перед публикацией буфера. Без SSE2 — обычный memcpy.
+
+Порог настраивается флагом сборки:
+    -DADV_VECTOR_STREAMING_COPY_BYTES=<байты>   // 0 отключает путь целиком
+Отдельный флаг -DADV_VECTOR_STREAMING_REALLOC распространяет потоковый
+перенос и на realloc-путь (см. RawMemory::Reallocate).
+*/
+#ifndef ADV_VECTOR_STREAMING_COPY_BYTES
+#define ADV_VECTOR_STREAMING_COPY_BYTES (4u << 20)
+#endif
+
+inline constexpr size_t kStreamingCopyBytes = ADV_VECTOR_STREAMING_COPY_BYTES;
+
+inline void AdvStreamingCopy(void* dst, const void* src, size_t bytes) noexcept {
+#if defined(__SSE2__)
+    auto* d = static_cast<unsigned char*>(dst);
+    auto* s = static_cast<const unsigned char*>(src);
+    // Пролог до 16-байтной границы приёмника: stream-store требует выравнивания.
+    size_t head = (16 - reinterpret_cast<uintptr_t>(d) % 16) % 16;
+    if (head > bytes) {
+        head = bytes;
+    }
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    bytes -= head;
+    const size_t blocks = bytes / 64;
+    for (size_t i = 0; i < blocks; ++i) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        const __m128i e = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), e);
+        d += 64;
+        s += 64;
+    }
+    _mm_sfence();
+    std::memcpy(d, s, bytes % 64);
+#else
+    std::memcpy(dst, src, bytes);
+#endif
+}
+
+//Телеметрия аллокаций (опциональная).
+/*
+Включается флагом сборки -DADV_VECTOR_TELEMETRY: RawMemory и пути переноса
+начинают атомарно считать события по всему процессу — выделения и
+освобождения буферов, запрошенные байты, realloc-расширения и перенесённые
+при реаллокации элементы. Снимок снимается VectorTelemetry::Take(), счётчики
+обнуляются Reset(). Без флага хуки — пустые inline-функции, и горячий путь
+не содержит ни одной лишней инструкции.
+*/
+struct VectorTelemetry {
+    struct Snapshot {
+        uint64_t allocations;
+        uint64_t deallocations;
+        uint64_t allocated_bytes;
+        uint64_t realloc_grows;
+        uint64_t relocated_elements;
+    };
+
+#ifdef ADV_VECTOR_TELEMETRY
+    static inline std::atomic<uint64_t> allocations{0};
+    static inline std::atomic<uint64_t> deallocations{0};
+    static inline std::atomic<uint64_t> allocated_bytes{0};
+    static inline std::atomic<uint64_t> realloc_grows{0};
+    static inline std::atomic<uint64_t> relocated_elements{0};
+
+    static Snapshot Take() noexcept {
+        return {allocations.load(std::memory_order_relaxed),
+                deallocations.load(std::memory_order_relaxed),
+                allocated_bytes.load(std::memory_order_relaxed),
+                realloc_grows.load(std::memory_order_relaxed),
+                relocated_elements.load(std::memory_order_relaxed)};
+    }
+
+    static void Reset() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        allocated_bytes.store(0, std::memory_order_relaxed);
+        realloc_grows.store(0, std::memory_order_relaxed);
+        relocated_elements.store(0, std::memory_order_relaxed);
+    }
+#else
+    static Snapshot Take() noexcept {
+        return {};
+    }
+
+    static void Reset() noexcept {
+    }
+#endif
+};
+
+// Хуки горячего пути; без ADV_VECTOR_TELEMETRY сворачиваются в ничто.
+inline void TelemetryNoteAllocate([[maybe_unused]] size_t bytes) noexcept {
+#ifdef ADV_VECTOR_TELEMETRY
+    VectorTelemetry::allocations.fetch_add(1, std::memory_order_relaxed);
+    VectorTelemetry::allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+}
+
+inline void TelemetryNoteDeallocate() noexcept {
+#ifdef ADV_VECTOR_TELEMETRY
+    VectorTelemetry::deallocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+}
+
+inline void TelemetryNoteRealloc([[maybe_unused]] size_t bytes) noexcept {
+#ifdef ADV_VECTOR_TELEMETRY
+    VectorTelemetry::realloc_grows.fetch_add(1, std::memory_order_relaxed);
+    VectorTelemetry::allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+#endif
+}
+
+inline void TelemetryNoteRelocate([[maybe_unused]] size_t count) noexcept {
+#ifdef ADV_VECTOR_TELEMETRY
+    VectorTelemetry::relocated_elements.fetch_add(count, std::memory_order_relaxed);
+#endif
+}
+
+/*
+Хук трассировки реаллокаций. Внешняя система (трейсер, профилировщик)
+подписывается один раз на процесс и получает вызов при каждом переносе или
+расширении буфера — с прежним и новым размером в байтах. Работает и без
+-DADV_VECTOR_TELEMETRY: цена при отключённом хуке — одна relaxed-загрузка
+указателя на реаллокацию, то есть вне горячего пути вставки. Хук обязан
+быть быстрым и не трогать векторы. nullptr снимает подписку.
+*/
+using VectorReallocHook = void (*)(size_t old_bytes, size_t new_bytes);
+
+inline std::atomic<VectorReallocHook>& VectorReallocHookSlot() noexcept {
+    static std::atomic<VectorReallocHook> hook{nullptr};
+    return hook;
+}
+
+inline void SetVectorReallocHook(VectorReallocHook hook) noexcept {
+    VectorReallocHookSlot().store(hook, std::memory_order_relaxed);
+}
+
+inline void TelemetryNoteReallocEvent(size_t old_bytes, size_t new_bytes) noexcept {
+    if (VectorReallocHook hook = VectorReallocHookSlot().load(std::memory_order_relaxed)) {
+        hook(old_bytes, new_bytes);
+    }
+}
+
+//Поддержка constexpr (C++20).
 /*
-Шаблонный класс RawMemory будет отвечать за хранение буфера, который вмещает заданное количество элементов, и предоставлять доступ к элементам по индексу:
+При сборке в C++20 основные операции Vector (конструкторы, рост, PushBack/
+EmplaceBack, Resize, присваивание, доступ) доступны в constant evaluation:
+память берётся у std::allocator (он constexpr), а memcpy-, malloc- и
+телеметрийные ветки обходятся через std::is_constant_evaluated. В C++17
+макрос разворачивается в пустоту и всё работает по-прежнему.
 */
+#if defined(__cpp_constexpr_dynamic_alloc) && __cpp_constexpr_dynamic_alloc >= 201907L \
+    && defined(__cpp_lib_is_constant_evaluated)
+#define ADV_VECTOR_HAS_CONSTEXPR_ALLOC 1
+#define ADV_VECTOR_CONSTEXPR constexpr
+#else
+#define ADV_VECTOR_HAS_CONSTEXPR_ALLOC 0
+#define ADV_VECTOR_CONSTEXPR
+#endif
+
+// true во время constant evaluation; в C++17 — всегда false
+ADV_VECTOR_CONSTEXPR inline bool AdvVectorIsConstEval() noexcept {
+#if ADV_VECTOR_HAS_CONSTEXPR_ALLOC
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+// placement new не разрешён в constexpr — в constant evaluation
+// конструирование идёт через std::construct_at
+template <typename T, typename... Args>
+ADV_VECTOR_CONSTEXPR T* AdvConstructAt(T* ptr, Args&&... args) {
+#if ADV_VECTOR_HAS_CONSTEXPR_ALLOC
+    if (std::is_constant_evaluated()) {
+        return std::construct_at(ptr, std::forward<Args>(args)...);
+    }
+#endif
+    return new (static_cast<void*>(ptr)) T(std::forward<Args>(args)...);
+}
+
+//Переключатель политики исключений.
+/*
+Сборка с -DADV_VECTOR_ASSUME_NOTHROW объявляет: конструкторы перемещения и
+копирования элементов не бросают, даже если формально не помечены noexcept.
+Перенос при реаллокации тогда всегда идёт по move-ветке, а try/catch-каркас
+строгой гарантии вычищается компилятором целиком. Если конструктор всё же
+бросит — поведение не определено, как и обещает режим. Предназначен для
+latency-критичных сборок, где типы заведомо просты, но унаследованы без
+noexcept-аннотаций.
+*/
+#ifdef ADV_VECTOR_ASSUME_NOTHROW
+inline constexpr bool kAssumeNothrowElements = true;
+#else
+inline constexpr bool kAssumeNothrowElements = false;
+#endif
+
+//Типаж тривиальной перемещаемости.
+/*
+Тип тривиально перемещаем, если "move-конструктор на новом месте плюс
+разрушение исходника" эквивалентны побайтовому переносу объекта. Это верно
+для всех тривиально копируемых типов (значение по умолчанию), а также для
+большинства RAII-обёрток — std::unique_ptr, дескрипторов и т.п., — которые
+не хранят указателей внутрь самих себя. Для такого типа перенос при
+реаллокации выполняется одним memcpy без вызова move-конструкторов и
+деструкторов. Включается явной специализацией:
+
+    template <>
+    struct IsTriviallyRelocatable<MyHandle> : std::true_type {};
+*/
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
 template <typename T>
+inline constexpr bool kIsTriviallyRelocatable = IsTriviallyRelocatable<T>::value;
+
+//Отдельный класс-обёртка, управляющий сырой памятью.
+/*
+Шаблонный класс RawMemory будет отвечать за хранение буфера, который вмещает заданное количество элементов, и предоставлять доступ к элементам по индексу.
+Память запрашивается у аллокатора Alloc (по умолчанию std::allocator<T>, то есть
+глобальные operator new/delete). Подменив аллокатор, можно разместить буфер в
+арене, пуле и т.п. — см. allocators.h.
+*/
+template <typename T, typename Alloc = std::allocator<T>>
 class RawMemory {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
+    /*
+    Для тривиально перемещаемых типов (IsTriviallyRelocatable) поверх
+    аллокатора по умолчанию буфер
+    размещается через malloc/free вместо operator new/delete. Это открывает
+    путь расширения через realloc: при удаче блок растёт на месте, без
+    копирования содержимого вообще. Перевыравненные типы исключаются —
+    malloc гарантирует только alignof(std::max_align_t).
+    */
+    static constexpr bool kCanReallocate =
+        kIsTriviallyRelocatable<T>
+        && std::is_same_v<Alloc, std::allocator<T>>
+        && alignof(T) <= alignof(std::max_align_t);
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    ADV_VECTOR_CONSTEXPR explicit RawMemory(const Alloc& alloc) noexcept
+        : alloc_(alloc) {
+    }
+
+    ADV_VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : alloc_(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
-    ~RawMemory() {Deallocate(buffer_);}
+    ADV_VECTOR_CONSTEXPR ~RawMemory() {Deallocate(buffer_);}
 
 
     /*
@@ -31,193 +292,663 @@ public:
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
-    RawMemory(RawMemory&& other) noexcept
-        : buffer_(std::exchange(other.buffer_, nullptr))
+    ADV_VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , buffer_(std::exchange(other.buffer_, nullptr))
         , capacity_(std::exchange(other.capacity_, 0)) {
 
         }
 
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
+    ADV_VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
 
         if (this != &rhs) {
-            buffer_ = std::move(rhs.buffer_);
-            capacity_ = std::move(rhs.capacity_);
-            rhs.buffer_ = nullptr;
-            rhs.capacity_ = 0;
+            // Прежний буфер нужно вернуть аллокатору, иначе он будет потерян.
+            Deallocate(buffer_);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(rhs.alloc_);
+            }
+            buffer_ = std::exchange(rhs.buffer_, nullptr);
+            capacity_ = std::exchange(rhs.capacity_, 0);
         }
 
         return *this;
     }
 
-    T* operator+(size_t offset) noexcept {
+    ADV_VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
         assert(offset <= capacity_); return buffer_ + offset;
         }
 
-    const T* operator+(size_t offset) const noexcept {
+    ADV_VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
         }
 
-    const T& operator[](size_t index) const noexcept {
+    ADV_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
         }
 
-    T& operator[](size_t index) noexcept {
+    ADV_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < capacity_); return buffer_[index];
         }
 
-    void Swap(RawMemory& other) noexcept {
+    ADV_VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
+        if constexpr (AllocTraits::propagate_on_container_swap::value) {
+            std::swap(alloc_, other.alloc_);
+        }
         std::swap(buffer_, other.buffer_); std::swap(capacity_, other.capacity_);
         }
 
-    const T* GetAddress() const noexcept {
+    ADV_VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
         }
 
-    T* GetAddress() noexcept {
+    ADV_VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
         }
 
-    size_t Capacity() const {
+    ADV_VECTOR_CONSTEXPR size_t Capacity() const {
         return capacity_;
         }
 
+    ADV_VECTOR_CONSTEXPR Alloc& GetAllocator() noexcept {
+        return alloc_;
+        }
+
+    ADV_VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept {
+        return alloc_;
+        }
+
+    // Расширяет буфер до new_capacity элементов через std::realloc.
+    // Байты переносит сама библиотека C, по возможности блок растёт на месте.
+    void Reallocate(size_t new_capacity) {
+        static_assert(kCanReallocate,
+                      "Reallocate доступен только для malloc-размещённых буферов");
+        // Приведение к void* осознанное: для типов, помеченных
+        // IsTriviallyRelocatable, побайтовый перенос корректен по определению.
+        const size_t old_bytes = capacity_ * sizeof(T);
+#ifdef ADV_VECTOR_STREAMING_REALLOC
+        /*
+        Принудительный потоковый перенос на realloc-пути: когда libc не может
+        расширить блок на месте, её внутренний memcpy прогоняет буфер через
+        кэш. С этим флагом крупные буферы переезжают в свежий блок
+        потоковыми записями. По умолчанию выключено: glibc для таких блоков
+        обычно делает mremap и не копирует байты вовсе — флаг нужен там, где
+        это не так.
+        */
+        if (kStreamingCopyBytes != 0 && old_bytes >= kStreamingCopyBytes) {
+            void* fresh = std::malloc(new_capacity * sizeof(T));
+            if (fresh == nullptr) {
+                throw std::bad_alloc();
+            }
+            AdvStreamingCopy(fresh, buffer_, old_bytes);
+            std::free(buffer_);
+            buffer_ = static_cast<T*>(fresh);
+            capacity_ = new_capacity;
+            TelemetryNoteRealloc(new_capacity * sizeof(T));
+            TelemetryNoteReallocEvent(old_bytes, new_capacity * sizeof(T));
+            return;
+        }
+#endif
+        void* grown = std::realloc(static_cast<void*>(buffer_), new_capacity * sizeof(T));
+        if (grown == nullptr) {
+            throw std::bad_alloc();
+        }
+        TelemetryNoteRealloc(new_capacity * sizeof(T));
+        TelemetryNoteReallocEvent(old_bytes, new_capacity * sizeof(T));
+        buffer_ = static_cast<T*>(grown);
+        capacity_ = new_capacity;
+    }
+
 private:
     // Выделяет сырую память под n элементов и возвращает указатель на неё
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    ADV_VECTOR_CONSTEXPR T* Allocate(size_t n) {
+        if (n == 0) {
+            return nullptr;
+        }
+        if (AdvVectorIsConstEval()) {
+            // В constant evaluation память умеет выдавать только std::allocator.
+            return AllocTraits::allocate(alloc_, n);
+        }
+        TelemetryNoteAllocate(n * sizeof(T));
+        if constexpr (kCanReallocate) {
+            void* ptr = std::malloc(n * sizeof(T));
+            if (ptr == nullptr) {
+                throw std::bad_alloc();
+            }
+            return static_cast<T*>(ptr);
+        } else {
+            return AllocTraits::allocate(alloc_, n);
+        }
     }
 
     // Освобождает сырую память, выделенную ранее по адресу buf при помощи Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    ADV_VECTOR_CONSTEXPR void Deallocate(T* buf) noexcept {
+        if (buf != nullptr) {
+            if (AdvVectorIsConstEval()) {
+                AllocTraits::deallocate(alloc_, buf, capacity_);
+                return;
+            }
+            TelemetryNoteDeallocate();
+            if constexpr (kCanReallocate) {
+                std::free(buf);
+            } else {
+                AllocTraits::deallocate(alloc_, buf, capacity_);
+            }
+        }
     }
 
+    Alloc alloc_{};
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
+//Политики роста ёмкости.
+/*
+Политика — это стратегия времени компиляции с единственным методом
+Next(capacity, required, element_size), возвращающим новую ёмкость
+(не меньше required). Подставляется третьим шаблонным параметром Vector.
+*/
+
+// Удвоение — политика по умолчанию, поведение прежних версий.
+struct GrowthDouble {
+    static constexpr size_t Next(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(capacity * 2, required);
+    }
+};
+
+// Рост в полтора раза: меньше пиковый расход памяти, чаще реаллокации.
+struct GrowthOnePointFive {
+    static constexpr size_t Next(size_t capacity, size_t required, size_t /*element_size*/) noexcept {
+        return std::max(capacity + capacity / 2 + 1, required);
+    }
+};
+
+// Ровно столько, сколько запрошено: каждое расширение — реаллокация.
+// Имеет смысл, когда итоговый размер известен и память дорога.
+struct GrowthExact {
+    static constexpr size_t Next(size_t /*capacity*/, size_t required, size_t /*element_size*/) noexcept {
+        return required;
+    }
+};
+
+// Удвоение с округлением байтового размера буфера вверх до целых страниц:
+// аллокатор не оставляет хвостов при работе поверх mmap и крупных арен.
+struct GrowthPageQuantized {
+    static constexpr size_t kPageSize = 4096;
+
+    static constexpr size_t Next(size_t capacity, size_t required, size_t element_size) noexcept {
+        const size_t target = std::max(capacity * 2, required);
+        const size_t bytes = ((target * element_size + kPageSize - 1) / kPageSize) * kPageSize;
+        return std::max(bytes / element_size, required);
+    }
+};
+
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = GrowthDouble>
 class Vector {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
 public:
 
     using iterator = T*;
     using const_iterator = const T*;
+    using allocator_type = Alloc;
 
-    iterator begin() noexcept {
+    ADV_VECTOR_CONSTEXPR iterator begin() noexcept {
         return data_.GetAddress();
     }
 
-    iterator end() noexcept {
+    ADV_VECTOR_CONSTEXPR iterator end() noexcept {
         return size_ + data_.GetAddress();
     }
 
-    const_iterator begin() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator begin() const noexcept {
         return cbegin();
     }
 
-    const_iterator end() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator end() const noexcept {
         return cend();
     }
 
-    const_iterator cbegin() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
         return data_.GetAddress();
     }
 
-    const_iterator cend() const noexcept {
+    ADV_VECTOR_CONSTEXPR const_iterator cend() const noexcept {
         return size_ + data_.GetAddress();
     }
 
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(size)
+    ADV_VECTOR_CONSTEXPR explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc) {
+        }
+
+    ADV_VECTOR_CONSTEXPR explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
         , size_(size)
         {
-            std::uninitialized_value_construct_n(data_.GetAddress(), size);
+            ValueConstructN(data_.GetAddress(), size);
+        }
+
+    /*
+    Конструктор из диапазона. Для forward-итераторов длина известна заранее:
+    одна точная аллокация и блочное копирование, без промежуточных ростов.
+    Однопроходные итераторы дозаписываются поэлементно с обычным ростом.
+    */
+    template <typename InputIt,
+              typename = typename std::iterator_traits<InputIt>::iterator_category>
+    Vector(InputIt first, InputIt last, const Alloc& alloc = Alloc())
+        : data_(RangeSizeHint(first, last), alloc) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            std::uninitialized_copy(first, last, data_.GetAddress());
+            size_ = data_.Capacity();
+        } else {
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            } catch (...) {
+                // Деструктор недостроенного объекта не вызывается —
+                // прибираем элементы сами, буфер освободит RawMemory.
+                std::destroy_n(data_.GetAddress(), size_);
+                throw;
+            }
         }
+    }
+
+    // Конструктор заполнения: size копий value в одной точной аллокации
+    // (тривиально копируемые типы заполняются через memset/сплэт).
+    Vector(size_t size, const T& value, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size) {
+        FillConstructN(data_.GetAddress(), size, value);
+    }
+
+    // Конструктор с генератором: ровно size элементов, построенных gen(index),
+    // в одной точной аллокации.
+    template <typename Generator,
+              typename = std::enable_if_t<std::is_invocable_v<Generator&, size_t>>>
+    Vector(size_t size, Generator gen, const Alloc& alloc = Alloc())
+        : data_(size, alloc) {
+        try {
+            for (size_t i = 0; i < size; ++i) {
+                new (data_ + size_) T(gen(i));
+                ++size_;
+            }
+        } catch (...) {
+            std::destroy_n(data_.GetAddress(), size_);
+            throw;
+        }
+    }
+
+    /*
+    Принимает готовый буфер, в котором первые count элементов уже
+    сконструированы — канал передачи без копирования из внешних механизмов
+    наполнения (см. ConcurrentAppendBuffer::TakeAsVector). Ответственность
+    за то, что элементы действительно построены, лежит на передающей стороне.
+    */
+    Vector(RawMemory<T, Alloc>&& buffer, size_t count) noexcept
+        : data_(std::move(buffer))
+        , size_(count) {
+        assert(size_ <= data_.Capacity());
+    }
 
-    Vector(const Vector& other)
-        : data_(other.size_)
+    ADV_VECTOR_CONSTEXPR Vector(const Vector& other)
+        : data_(other.size_,
+                AllocTraits::select_on_container_copy_construction(other.data_.GetAllocator()))
         , size_(other.size_)
         {
-            std::uninitialized_copy_n(other.data_.GetAddress(), size_, data_.GetAddress());
+            CopyConstructN(other.data_.GetAddress(), size_, data_.GetAddress());
         }
 
-    Vector(Vector&& other) noexcept
+    ADV_VECTOR_CONSTEXPR Vector(Vector&& other) noexcept
         : data_(std::move(other.data_))
         , size_(std::exchange(other.size_, 0)) {
 
         }
 
-    ~Vector() {
+    ADV_VECTOR_CONSTEXPR ~Vector() {
         std::destroy_n(data_.GetAddress(), size_);
     }
 
-    size_t Size() const noexcept {
+    ADV_VECTOR_CONSTEXPR size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    ADV_VECTOR_CONSTEXPR size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    void Swap(Vector& other) noexcept {
+    ADV_VECTOR_CONSTEXPR allocator_type GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    ADV_VECTOR_CONSTEXPR void Swap(Vector& other) noexcept {
         data_.Swap(other.data_), std::swap(size_, other.size_);
     }
 
-    void Reserve(size_t new_capacity) {
+    ADV_VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
+        if (!AdvVectorIsConstEval()) {
+            if constexpr (RawMemory<T, Alloc>::kCanReallocate) {
+                // realloc переносит байты сам и по возможности расширяет блок
+                // на месте — тогда копирования не происходит вовсе.
+                data_.Reallocate(new_capacity);
+                return;
+            }
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
 
-        // constexpr оператор if будет вычислен во время компиляции
+        RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
 
-        /*
-        Я не стал убирать, т.к. из двух PushBack дублирование убралось,
-        а в других местах все же немного другие проверки, есть блоки try-catch
-        */
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        } else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        // Для тривиально копируемых типов исходные элементы уже «уехали» через memcpy,
+        // вызывать для них деструкторы не нужно.
+        if constexpr (!kIsTriviallyRelocatable<T>) {
+            std::destroy_n(data_.GetAddress(), size_);
+        }
+        if (!AdvVectorIsConstEval()) {
+            TelemetryNoteReallocEvent(data_.Capacity() * sizeof(T), new_data.Capacity() * sizeof(T));
         }
+        data_.Swap(new_data);
+    }
 
-            std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(new_data);
+    /*
+    Усечение ёмкости для долгоживущих векторов: после пика нагрузки буфер,
+    раздутый удвоением, может держать вдвое больше памяти, чем нужно.
+    TrimCapacityTo отпускает излишек до заданной границы (не ниже размера),
+    ShrinkToFit — до точного размера. Для malloc-буферов усечение делает
+    realloc, обычно на месте и без копирования.
+    */
+    ADV_VECTOR_CONSTEXPR void TrimCapacityTo(size_t new_capacity) {
+        if (new_capacity < size_) {
+            new_capacity = size_;
+        }
+        if (new_capacity >= data_.Capacity()) {
+            return;
+        }
+        if (new_capacity == 0) {
+            // Пустой вектор просто отпускает буфер.
+            data_ = RawMemory<T, Alloc>(data_.GetAllocator());
+            return;
+        }
+        if (!AdvVectorIsConstEval()) {
+            if constexpr (RawMemory<T, Alloc>::kCanReallocate) {
+                data_.Reallocate(new_capacity);
+                return;
+            }
+        }
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        if (size_ != 0) {
+            RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+            if constexpr (!kIsTriviallyRelocatable<T>) {
+                std::destroy_n(data_.GetAddress(), size_);
+            }
+        }
+        if (!AdvVectorIsConstEval()) {
+            TelemetryNoteReallocEvent(data_.Capacity() * sizeof(T), new_data.Capacity() * sizeof(T));
+        }
+        data_.Swap(new_data);
+    }
+
+    ADV_VECTOR_CONSTEXPR void ShrinkToFit() {
+        TrimCapacityTo(size_);
     }
 
-    void Resize(size_t new_size) {
+    ADV_VECTOR_CONSTEXPR void Resize(size_t new_size) {
         if (new_size < size_) {
             std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
         }
         else {
             if (new_size > data_.Capacity()) {
-                const size_t new_capacity = std::max(data_.Capacity() * 2, new_size);
+                const size_t new_capacity = Growth::Next(data_.Capacity(), new_size, sizeof(T));
                 Reserve(new_capacity);
             }
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            ValueConstructN(data_.GetAddress() + size_, new_size - size_);
         }
         size_ = new_size;
     }
 
-    void PushBack(const T& value) {
+    // Resize с заполнением: достроенный хвост — копии value, через то же
+    // векторизованное заполнение (memset/сплэт), что и Assign.
+    void Resize(size_t new_size, const T& value) {
+        // value может указывать на элемент этого же вектора, а рост
+        // перемещает буфер — снимаем копию заранее.
+        const bool internal = std::addressof(value) >= begin()
+                              && std::addressof(value) < end();
+        if (internal) {
+            T copy(value);
+            Resize(new_size, copy);
+            return;
+        }
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        } else {
+            if (new_size > data_.Capacity()) {
+                Reserve(Growth::Next(data_.Capacity(), new_size, sizeof(T)));
+            }
+            FillConstructN(data_.GetAddress() + size_, new_size - size_, value);
+        }
+        size_ = new_size;
+    }
+
+    // Перезаписывает все текущие элементы копиями value, размер не меняется.
+    void Fill(const T& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            const bool internal = std::addressof(value) >= begin()
+                                  && std::addressof(value) < end();
+            if (internal) {
+                T copy(value);
+                FillConstructN(data_.GetAddress(), size_, copy);
+            } else {
+                FillConstructN(data_.GetAddress(), size_, value);
+            }
+        } else {
+            std::fill_n(data_.GetAddress(), size_, value);
+        }
+    }
+
+    /*
+    Resize без инициализации новых элементов: для тривиальных типов хвост
+    остаётся с неопределённым значением (нетривиальные типы конструируются
+    по умолчанию, как предписывает uninitialized_default_construct_n).
+    Предназначен для буферов, которые тут же заполняются извне — декодером,
+    readv и т.п., — где обнуление было бы выброшенной работой.
+    */
+    void ResizeForOverwrite(size_t new_size) {
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+        } else {
+            if (new_size > data_.Capacity()) {
+                Reserve(Growth::Next(data_.Capacity(), new_size, sizeof(T)));
+            }
+            std::uninitialized_default_construct_n(data_.GetAddress() + size_, new_size - size_);
+        }
+        size_ = new_size;
+    }
+
+    /*
+    Интерфейс прямой записи в запасную ёмкость: писатель получает указатель
+    на сырое место за последним элементом (SpareData, SpareCapacity слотов),
+    конструирует там элементы сам и узаконивает их одним CommitAppended.
+    */
+    size_t SpareCapacity() const noexcept {
+        return data_.Capacity() - size_;
+    }
+
+    T* SpareData() noexcept {
+        return data_ + size_;
+    }
+
+    // Учитывает n элементов, уже сконструированных в запасной ёмкости.
+    void CommitAppended(size_t n) noexcept {
+        assert(n <= SpareCapacity());
+        size_ += n;
+    }
+
+    // Парный учёт для внешних механизмов разрушения (см. parallel_init.h):
+    // последние n элементов считаются уже разрушенными извне.
+    void DiscardDestroyed(size_t n) noexcept {
+        assert(n <= size_);
+        size_ -= n;
+    }
+
+    ADV_VECTOR_CONSTEXPR void PushBack(const T& value) {
         EmplaceBack(std::forward<const T&>(value));
     }
 
-    void PushBack(T&& value) {
+    ADV_VECTOR_CONSTEXPR void PushBack(T&& value) {
         EmplaceBack(std::forward<T&&>(value));
     }
 
-    void PopBack() noexcept {
+    ADV_VECTOR_CONSTEXPR void Clear() noexcept {
+        std::destroy_n(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    /*
+    Замена содержимого с переиспользованием памяти. В отличие от operator=,
+    который при нехватке ёмкости строит копию и обменивается с ней (и тем
+    самым трогает память дважды), Assign пишет в существующий буфер, когда
+    count помещается, а иначе разрушает старые элементы и заполняет ровно
+    один новый буфер. Взамен гарантия при исключении слабеет до базовой.
+    */
+    void Assign(size_t count, const T& value) {
+        // value может указывать на элемент этого же вектора
+        const bool internal = std::addressof(value) >= begin()
+                              && std::addressof(value) < end();
+        if (internal) {
+            T copy(value);
+            Assign(count, copy);
+            return;
+        }
+        if (count <= data_.Capacity()) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                // Живые тривиальные элементы можно просто перезаписать байтами.
+                FillConstructN(data_.GetAddress(), count, value);
+            } else {
+                const size_t overlap = std::min(size_, count);
+                std::fill_n(data_.GetAddress(), overlap, value);
+                if (count > size_) {
+                    FillConstructN(data_.GetAddress() + size_, count - size_, value);
+                } else {
+                    std::destroy_n(data_.GetAddress() + count, size_ - count);
+                }
+            }
+        } else {
+            Clear();
+            data_ = RawMemory<T, Alloc>(count, data_.GetAllocator());
+            FillConstructN(data_.GetAddress(), count, value);
+        }
+        size_ = count;
+    }
+
+    // Диапазон не должен указывать внутрь этого же вектора. SFINAE по
+    // iterator_category, чтобы Assign(5, 7) уходил в перегрузку заполнения,
+    // а не выводил InputIt = int.
+    template <typename InputIt,
+              typename = typename std::iterator_traits<InputIt>::iterator_category>
+    void Assign(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            if (count <= data_.Capacity()) {
+                const size_t overlap = std::min(size_, count);
+                InputIt mid = first;
+                std::advance(mid, overlap);
+                std::copy(first, mid, data_.GetAddress());
+                if (count > size_) {
+                    std::uninitialized_copy(mid, last, data_.GetAddress() + size_);
+                } else {
+                    std::destroy_n(data_.GetAddress() + count, size_ - count);
+                }
+            } else {
+                Clear();
+                data_ = RawMemory<T, Alloc>(count, data_.GetAllocator());
+                std::uninitialized_copy(first, last, data_.GetAddress());
+            }
+            size_ = count;
+        } else {
+            Clear();
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    /*
+    Пакетное дописывание в конец. В отличие от цикла из PushBack требуемая
+    ёмкость вычисляется один раз, реаллокация происходит не более одного раза,
+    а хвост конструируется целым блоком (std::uninitialized_copy для диапазона
+    тривиально копируемых T из указателей сворачивается в memmove).
+    */
+    // Диапазон не должен указывать внутрь этого же вектора — для дописывания
+    // вектора к самому себе есть перегрузка от Vector.
+    template <typename InputIt>
+    void AppendRange(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const size_t count = static_cast<size_t>(std::distance(first, last));
+            EnsureRoomFor(count);
+            std::uninitialized_copy(first, last, data_.GetAddress() + size_);
+            size_ += count;
+        } else {
+            // Однопроходный итератор: заранее узнать длину нельзя.
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
+
+    void AppendRange(const Vector& other) {
+        // Дописывание вектора к самому себе: ёмкость резервируется до того,
+        // как будут взяты указатели, иначе они протухнут после реаллокации.
+        EnsureRoomFor(other.size_);
+        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_,
+                                  data_.GetAddress() + size_);
+        size_ += other.size_;
+    }
+
+    // Дописывает count элементов, построенных генератором gen(index).
+    // Размер наращивается поэлементно, чтобы исключение из генератора
+    // не оставило в хвосте неучтённые сконструированные элементы.
+    template <typename Generator>
+    void AppendGenerated(size_t count, Generator gen) {
+        EnsureRoomFor(count);
+        for (size_t i = 0; i < count; ++i) {
+            new (data_ + size_) T(gen(i));
+            ++size_;
+        }
+    }
+
+    ADV_VECTOR_CONSTEXPR void PopBack() noexcept {
         if (size_ > 0) {
             std::destroy_at(data_.GetAddress() + size_ - 1);
             --size_;
         }
     }
 
-    Vector& operator=(const Vector& other) {
+    ADV_VECTOR_CONSTEXPR Vector& operator=(const Vector& other) {
         if (this != &other) {
+            if constexpr (AllocTraits::propagate_on_container_copy_assignment::value
+                          && !AllocTraits::is_always_equal::value) {
+                if (data_.GetAllocator() != other.data_.GetAllocator()) {
+                    // POCCA с неравными аллокаторами: наш буфер нельзя
+                    // переиспользовать — освобождаем его прежним аллокатором,
+                    // переносим аллокатор и берём память уже у нового.
+                    Clear();
+                    data_ = RawMemory<T, Alloc>(data_.GetAllocator());
+                    data_.GetAllocator() = other.data_.GetAllocator();
+                    RawMemory<T, Alloc> new_data(other.size_, data_.GetAllocator());
+                    CopyConstructN(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+                    data_.Swap(new_data);
+                    size_ = other.size_;
+                    return *this;
+                }
+                // Равные аллокаторы: перенос — формальность, память переиспользуема.
+                data_.GetAllocator() = other.data_.GetAllocator();
+            }
             if (other.size_ <= data_.Capacity()) {
                 if (size_ <= other.size_) {
 
@@ -225,9 +956,9 @@ public:
                               other.data_.GetAddress() + size_,
                               data_.GetAddress());
 
-                    std::uninitialized_copy_n(other.data_.GetAddress() + size_,
-                                              other.size_ - size_,
-                                              data_.GetAddress() + size_);
+                    CopyConstructN(other.data_.GetAddress() + size_,
+                                   other.size_ - size_,
+                                   data_.GetAddress() + size_);
                 } else {
                     std::copy(other.data_.GetAddress(),
                               other.data_.GetAddress() + other.size_,
@@ -240,32 +971,67 @@ public:
                 size_ = other.size_;
 
             } else {
-                Vector other_copy(other);
-                Swap(other_copy);
+                // Новая память берётся НАШИМ аллокатором: без POCCA копирующее
+                // присваивание аллокатор не меняет (раньше copy-and-swap
+                // протаскивал чужой через SOCCC + обмен).
+                RawMemory<T, Alloc> new_data(other.size_, data_.GetAllocator());
+                CopyConstructN(other.data_.GetAddress(), other.size_, new_data.GetAddress());
+                std::destroy_n(data_.GetAddress(), size_);
+                data_.Swap(new_data);
+                size_ = other.size_;
             }
         }
 
         return *this;
     }
 
-    Vector& operator = (Vector&& other) noexcept {
-        Swap(other); return *this;
+    ADV_VECTOR_CONSTEXPR Vector& operator = (Vector&& other) noexcept(
+        AllocTraits::propagate_on_container_move_assignment::value
+        || std::allocator_traits<Alloc>::is_always_equal::value) {
+        if constexpr (AllocTraits::is_always_equal::value) {
+            Swap(other);
+        } else if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+            // Настоящая кража, а не Swap: RawMemory::Swap обменивает
+            // аллокаторы только при propagate_on_container_swap, и при
+            // POCMA без POCS буфер уехал бы без своего аллокатора —
+            // а освобождать его чужим нельзя. Move-присваивание RawMemory
+            // освобождает наш буфер нашим аллокатором и забирает чужой
+            // вместе с его аллокатором.
+            if (this != &other) {
+                std::destroy_n(data_.GetAddress(), size_);
+                data_ = std::move(other.data_);
+                size_ = std::exchange(other.size_, 0);
+            }
+        } else {
+            // Аллокатор не переезжает вместе с буфером: если аллокаторы не равны,
+            // чужой буфер освобождать нашим аллокатором нельзя — переносим поэлементно.
+            if (data_.GetAllocator() == other.data_.GetAllocator()) {
+                Swap(other);
+            } else {
+                std::destroy_n(data_.GetAddress(), size_);
+                size_ = 0;
+                Reserve(other.size_);
+                std::uninitialized_move_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+                size_ = other.size_;
+            }
+        }
+        return *this;
     }
 
     /*
     В константном операторе [] используется оператор  const_cast, чтобы снять константность с ссылки на текущий объект и вызвать неконстантную версию оператора []. Так получится избавиться от дублирования проверки assert(index < size). Оператор const_cast позволяет сделать то, что нельзя, но, если очень хочется, можно. В данном случае нельзя вызвать неконстантный метод из константного. Но неконстантный оператор [] тут не модифицирует состояние объекта, поэтому его можно вызвать, предварительно сняв константность с объекта.
     */
-    const T& operator[](size_t index) const noexcept {
+    ADV_VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
+    ADV_VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
         assert(index < size_); return data_[index];
     }
 
 
     template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
+    ADV_VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
         /*
         Тренажер не хочет принимать реализацию
         return *Emplace(cend(), std::forward<Args>(args)...);
@@ -279,66 +1045,183 @@ public:
 
         T* result = nullptr;
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            result = new (new_data + size_) T(std::forward<Args>(args)...);
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
+            if (!AdvVectorIsConstEval()) {
+                if constexpr (RawMemory<T, Alloc>::kCanReallocate) {
+                    // args могут ссылаться на элемент этого же вектора, а realloc
+                    // освобождает старый блок — значение снимается до расширения.
+                    T value(std::forward<Args>(args)...);
+                    data_.Reallocate(Growth::Next(data_.Capacity(), size_ + 1, sizeof(T)));
+                    result = new (data_ + size_) T(std::move(value));
+                    ++size_;
+                    return *result;
+                }
+            }
+            RawMemory<T, Alloc> new_data(Growth::Next(data_.Capacity(), size_ + 1, sizeof(T)), data_.GetAllocator());
+            result = AdvConstructAt(new_data.GetAddress() + size_, std::forward<Args>(args)...);
+            if constexpr (kNothrowRelocate) {
+                RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
             }
             else {
                 try {
-                    std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+                    RelocateN(data_.GetAddress(), size_, new_data.GetAddress());
                 }
                 catch (...) {
                     std::destroy_n(new_data.GetAddress() + size_, 1);
                     throw;
                 }
             }
-            std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(new_data);
+            if constexpr (!kIsTriviallyRelocatable<T>) {
+                std::destroy_n(data_.GetAddress(), size_);
+            }
+            if (!AdvVectorIsConstEval()) {
+            TelemetryNoteReallocEvent(data_.Capacity() * sizeof(T), new_data.Capacity() * sizeof(T));
+        }
+        data_.Swap(new_data);
         }
         else {
-            result = new (data_ + size_) T(std::forward<Args>(args)...);
+            result = AdvConstructAt(data_.GetAddress() + size_, std::forward<Args>(args)...);
+        }
+        ++size_;
+        return *result;
+    }
+
+    /*
+    Небросающие версии для latency-критичных путей: исчерпание памяти —
+    ожидаемый исход (например, заполнение буфера фиксированного бюджета),
+    а не авария. bad_alloc гасится у самой границы аллокации и превращается
+    в false/nullptr, вектор при этом остаётся нетронутым. Исключения
+    конструкторов элементов не скрываются — это ошибки другого сорта.
+    */
+    bool TryReserve(size_t new_capacity) {
+        if (new_capacity <= data_.Capacity()) {
+            return true;
+        }
+        try {
+            Reserve(new_capacity);
+        } catch (const std::bad_alloc&) {
+            return false;
         }
+        return true;
+    }
+
+    template <typename... Args>
+    T* TryEmplaceBack(Args&&... args) {
+        try {
+            return std::addressof(EmplaceBack(std::forward<Args>(args)...));
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+
+    bool TryPushBack(const T& value) {
+        return TryEmplaceBack(value) != nullptr;
+    }
+
+    bool TryPushBack(T&& value) {
+        return TryEmplaceBack(std::move(value)) != nullptr;
+    }
+
+    /*
+    Горячий путь без проверки ёмкости: вызывающий сам гарантирует, что
+    Size() < Capacity() — обычно одним Reserve на весь батч перед циклом.
+    Ни ветвления на рост, ни реаллокации; в отладочной сборке контракт
+    страхуется assert'ом.
+    */
+    template <typename... Args>
+    ADV_VECTOR_CONSTEXPR T& EmplaceBackUnchecked(Args&&... args) {
+        assert(size_ < data_.Capacity());
+        T* result = AdvConstructAt(data_.GetAddress() + size_, std::forward<Args>(args)...);
         ++size_;
         return *result;
     }
 
+    ADV_VECTOR_CONSTEXPR void PushBackUnchecked(const T& value) {
+        EmplaceBackUnchecked(value);
+    }
+
+    ADV_VECTOR_CONSTEXPR void PushBackUnchecked(T&& value) {
+        EmplaceBackUnchecked(std::move(value));
+    }
+
     template <typename... Args>
     iterator Emplace(const_iterator pos, Args&&... args) {
         assert(pos >= begin() && pos <= end());
         size_t shift = pos - begin();
         iterator result = nullptr;
         if (size_ == Capacity()) {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
+            if constexpr (RawMemory<T, Alloc>::kCanReallocate) {
+                T value(std::forward<Args>(args)...);
+                data_.Reallocate(Growth::Next(data_.Capacity(), size_ + 1, sizeof(T)));
+                std::memmove(static_cast<void*>(data_.GetAddress() + shift + 1),
+                             static_cast<const void*>(data_.GetAddress() + shift),
+                             (size_ - shift) * sizeof(T));
+                result = new (data_ + shift) T(std::move(value));
+                ++size_;
+                return result;
+            }
+            RawMemory<T, Alloc> new_data(Growth::Next(data_.Capacity(), size_ + 1, sizeof(T)), data_.GetAllocator());
             result = new (new_data + shift) T(std::forward<Args>(args)...);
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(data_.GetAddress(), shift, new_data.GetAddress());
-                std::uninitialized_move_n(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
+            if constexpr (kNothrowRelocate) {
+                RelocateN(data_.GetAddress(), shift, new_data.GetAddress());
+                RelocateN(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
             }
             else {
                 try {
-                    std::uninitialized_copy_n(data_.GetAddress(), shift, new_data.GetAddress());
-                    std::uninitialized_copy_n(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
+                    RelocateN(data_.GetAddress(), shift, new_data.GetAddress());
                 }
                 catch (...) {
                     std::destroy_n(new_data.GetAddress() + shift, 1);
                     throw;
                 }
+                try {
+                    RelocateN(data_.GetAddress() + shift, size_ - shift, new_data.GetAddress() + shift + 1);
+                }
+                catch (...) {
+                    // Скопированный префикс и вставленный элемент нужно разрушить,
+                    // иначе их деструкторы никогда не будут вызваны.
+                    std::destroy_n(new_data.GetAddress(), shift + 1);
+                    throw;
+                }
+            }
+            if constexpr (!kIsTriviallyRelocatable<T>) {
+                std::destroy_n(begin(), size_);
             }
-            std::destroy_n(begin(), size_);
-            data_.Swap(new_data);
+            if (!AdvVectorIsConstEval()) {
+            TelemetryNoteReallocEvent(data_.Capacity() * sizeof(T), new_data.Capacity() * sizeof(T));
+        }
+        data_.Swap(new_data);
         }
         else {
-            if (size_ != 0) {
+            if constexpr (kIsTriviallyRelocatable<T>) {
+                // Хвост раздвигается одним memmove вместо move-конструктора
+                // последнего элемента и move_backward по остальным. Значение
+                // снимается заранее: args могут ссылаться на сдвигаемый хвост.
+                T value(std::forward<Args>(args)...);
+                std::memmove(static_cast<void*>(data_.GetAddress() + shift + 1),
+                             static_cast<const void*>(data_.GetAddress() + shift),
+                             (size_ - shift) * sizeof(T));
+                result = new (data_ + shift) T(std::move(value));
+                ++size_;
+                return result;
+            }
+            if (shift != size_) {
                 new (data_ + size_) T(std::move(*(data_.GetAddress() + size_ - 1)));
-                try {
+                // Сдвигаем [shift, size_ - 1) вправо на один элемент;
+                // последний элемент уже перемещён в слот size_ выше.
+                if constexpr (kAssumeNothrowElements || std::is_nothrow_move_assignable_v<T>) {
                     std::move_backward(begin() + shift,
-                        data_.GetAddress() + size_,
-                        data_.GetAddress() + size_ + 1);
-                }
-                catch (...) {
-                    std::destroy_n(data_.GetAddress() + size_, 1);
-                    throw;
+                        data_.GetAddress() + size_ - 1,
+                        data_.GetAddress() + size_);
+                } else {
+                    try {
+                        std::move_backward(begin() + shift,
+                            data_.GetAddress() + size_ - 1,
+                            data_.GetAddress() + size_);
+                    }
+                    catch (...) {
+                        std::destroy_n(data_.GetAddress() + size_, 1);
+                        throw;
+                    }
                 }
                 std::destroy_at(begin() + shift);
             }
@@ -352,11 +1235,101 @@ public:
     iterator Erase(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
         assert(pos >= begin() && pos < end());
         size_t shift = pos - begin();
-        std::move(begin() + shift + 1, end(), begin() + shift);
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            // Удаляемый элемент разрушается (для тривиально копируемых типов
+            // это no-op), хвост сдвигается одним memmove; последний слот после
+            // побайтового переноса разрушать нельзя — достаточно уменьшить размер.
+            std::destroy_at(begin() + shift);
+            std::memmove(static_cast<void*>(begin() + shift),
+                         static_cast<const void*>(begin() + shift + 1),
+                         (size_ - shift - 1) * sizeof(T));
+            --size_;
+        } else {
+            std::move(begin() + shift + 1, end(), begin() + shift);
+            PopBack();
+        }
+        return begin() + shift;
+    }
+
+    /*
+    Удаление без сохранения порядка: на место удаляемого встаёт последний
+    элемент — O(1) вместо сдвига всего хвоста. Порядок оставшихся элементов
+    при этом нарушается, что для множеств «мешок записей» и очередей задач
+    обычно безразлично.
+    */
+    iterator SwapRemove(const_iterator pos) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        assert(pos >= begin() && pos < end());
+        const size_t shift = pos - begin();
+        if (shift + 1 != size_) {
+            data_[shift] = std::move(data_[size_ - 1]);
+        }
         PopBack();
         return begin() + shift;
     }
 
+    // Удаляет все элементы под pred, затыкая дыры последними элементами.
+    // Каждый элемент перемещается не более одного раза; порядок не сохраняется.
+    template <typename Pred>
+    size_t SwapRemoveIf(Pred pred) {
+        size_t removed = 0;
+        for (size_t i = 0; i < size_;) {
+            if (pred(data_[i])) {
+                if (i + 1 != size_) {
+                    data_[i] = std::move(data_[size_ - 1]);
+                }
+                std::destroy_at(data_.GetAddress() + size_ - 1);
+                --size_;
+                ++removed;
+                // i не двигаем: переехавший с конца элемент тоже надо проверить
+            } else {
+                ++i;
+            }
+        }
+        return removed;
+    }
+
+    // Удаляет диапазон [first, last) за один сдвиг хвоста вместо
+    // поэлементных вызовов Erase с квадратичной перетасовкой.
+    iterator EraseRange(const_iterator first, const_iterator last)
+        noexcept(std::is_nothrow_move_assignable_v<T>) {
+        assert(begin() <= first && first <= last && last <= end());
+        const size_t shift = first - begin();
+        const size_t count = last - first;
+        if (count == 0) {
+            return begin() + shift;
+        }
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            std::destroy_n(begin() + shift, count);
+            std::memmove(static_cast<void*>(begin() + shift),
+                         static_cast<const void*>(begin() + shift + count),
+                         (size_ - shift - count) * sizeof(T));
+        } else {
+            std::move(begin() + shift + count, end(), begin() + shift);
+            std::destroy_n(begin() + (size_ - count), count);
+        }
+        size_ -= count;
+        return begin() + shift;
+    }
+
+    // Удаляет все элементы, для которых pred(elem) == true, одним проходом
+    // с уплотнением на месте. Возвращает число удалённых элементов.
+    template <typename Pred>
+    size_t EraseIf(Pred pred) {
+        iterator out = begin();
+        for (iterator it = begin(); it != end(); ++it) {
+            if (!pred(*it)) {
+                if (out != it) {
+                    *out = std::move(*it);
+                }
+                ++out;
+            }
+        }
+        const size_t removed = static_cast<size_t>(end() - out);
+        std::destroy_n(out, removed);
+        size_ -= removed;
+        return removed;
+    }
+
     iterator Insert(const_iterator pos, const T& value) {
         return Emplace(pos, value);
     }
@@ -366,7 +1339,148 @@ public:
     }
 
 private:
-    RawMemory<T> data_;
+    // Длина диапазона, когда она известна до обхода: у однопроходных
+    // итераторов — 0, буфер растёт уже по ходу вставки.
+    template <typename InputIt>
+    static size_t RangeSizeHint(InputIt first, InputIt last) {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            return static_cast<size_t>(std::distance(first, last));
+        } else {
+            (void)first; (void)last;
+            return 0;
+        }
+    }
+
+    // Гарантирует место ещё под count элементов сверх текущего размера,
+    // выполняя не более одной реаллокации с обычной политикой роста.
+    ADV_VECTOR_CONSTEXPR void EnsureRoomFor(size_t count) {
+        if (count > data_.Capacity() - size_) {
+            Reserve(Growth::Next(data_.Capacity(), size_ + count, sizeof(T)));
+        }
+    }
+
+    // Перенос элементов при реаллокации не бросает исключений, если тип тривиально
+    // копируем (memcpy) или перемещается без исключений.
+    static constexpr bool kNothrowRelocate =
+        kAssumeNothrowElements
+        || kIsTriviallyRelocatable<T>
+        || std::is_nothrow_move_constructible_v<T>
+        || !std::is_copy_constructible_v<T>;
+
+    // Конструирование блока: в constant evaluation — поэлементный construct_at,
+    // в рантайме — обычные uninitialized-алгоритмы.
+    static ADV_VECTOR_CONSTEXPR void ValueConstructN(T* first, size_t count) {
+        if (AdvVectorIsConstEval()) {
+            for (size_t i = 0; i < count; ++i) {
+                AdvConstructAt(first + i);
+            }
+            return;
+        }
+        // Для тривиальных типов value-инициализация — это нули: один memset
+        // вместо поэлементного цикла.
+        if constexpr (std::is_trivial_v<T>) {
+            if (count != 0) {
+                std::memset(static_cast<void*>(first), 0, count * sizeof(T));
+            }
+            return;
+        }
+        std::uninitialized_value_construct_n(first, count);
+    }
+
+    /*
+    Заполнение значением. Однобайтовые типы уходят в memset; многобайтовые
+    тривиально копируемые — в memset при нулевом образе значения, иначе в
+    «сплэт» удвоением (log2(count) вызовов memcpy, каждый из которых libc
+    векторизует). Остальные типы — обычный uninitialized_fill_n. Для
+    тривиально копируемых типов допустимо и поверх живых элементов.
+    */
+    static void FillConstructN(T* first, size_t count, const T& value) {
+        if (count == 0) {
+            return;
+        }
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if constexpr (sizeof(T) == 1) {
+                unsigned char byte;
+                std::memcpy(&byte, &value, 1);
+                std::memset(static_cast<void*>(first), byte, count);
+                return;
+            } else {
+                if (IsAllZeroBytes(value)) {
+                    std::memset(static_cast<void*>(first), 0, count * sizeof(T));
+                    return;
+                }
+                std::memcpy(static_cast<void*>(first), &value, sizeof(T));
+                size_t filled = 1;
+                while (filled < count) {
+                    const size_t chunk = std::min(filled, count - filled);
+                    std::memcpy(static_cast<void*>(first + filled),
+                                static_cast<const void*>(first), chunk * sizeof(T));
+                    filled += chunk;
+                }
+                return;
+            }
+        } else {
+            std::uninitialized_fill_n(first, count, value);
+        }
+    }
+
+    static bool IsAllZeroBytes(const T& value) noexcept {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        for (unsigned char b : bytes) {
+            if (b != 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static ADV_VECTOR_CONSTEXPR void CopyConstructN(const T* from, size_t count, T* to) {
+        if (AdvVectorIsConstEval()) {
+            for (size_t i = 0; i < count; ++i) {
+                AdvConstructAt(to + i, from[i]);
+            }
+            return;
+        }
+        std::uninitialized_copy_n(from, count, to);
+    }
+
+    // Переносит count элементов из сырой памяти from в сырую память to.
+    // Для тривиально перемещаемых типов поэлементный цикл заменяется на memcpy
+    // (исходники при этом разрушать нельзя — они «переехали» целиком):
+    // на -O2 компилятор не всегда сворачивает uninitialized_move_n в bulk-копию,
+    // а на горячем пути реаллокации это заметно.
+    static ADV_VECTOR_CONSTEXPR void RelocateN(T* from, size_t count, T* to) {
+        if (AdvVectorIsConstEval()) {
+            // memcpy в constexpr недоступен — переносим поэлементно.
+            for (size_t i = 0; i < count; ++i) {
+                AdvConstructAt(to + i, std::move(from[i]));
+            }
+            return;
+        }
+        TelemetryNoteRelocate(count);
+        if constexpr (kIsTriviallyRelocatable<T>) {
+            if (count != 0) {
+                const size_t bytes = count * sizeof(T);
+                if (kStreamingCopyBytes != 0 && bytes >= kStreamingCopyBytes) {
+                    // Очень большой перенос: мимо кэша, чтобы не вытеснять
+                    // рабочий набор процесса.
+                    AdvStreamingCopy(to, from, bytes);
+                } else {
+                    std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), bytes);
+                }
+            }
+        } else if constexpr (kAssumeNothrowElements
+                             || std::is_nothrow_move_constructible_v<T>
+                             || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, count, to);
+        } else {
+            std::uninitialized_copy_n(from, count, to);
+        }
+    }
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
 };
 